@@ -1,85 +1,97 @@
 // Copyright  Allan Moore April 2020
 
 #include "Common.h"
-#include "Cartridge.h"
-#include "CPU.h"
-#include "PPU.h"
-#include "APU.h"
-#include "WaveformGenerator.h"
+#include "Console.h"
+#include "Rewind.h"
+#include "RunAhead.h"
+#include "SDLFrontend.h"
+
+#undef main
 
 using namespace ControlDeck;
 
-int main()
+// Frames run per tick while fast forwarding, all but the last with rendering off
+static const uint FAST_FORWARD_SPEED = 4;
+
+int main(int argc, char** argv)
 {
-    SharedPtr<Cartridge> rom = std::make_shared<Cartridge>();
-    //rom->Load(".\\mario.nes");
-    //rom->Load(".\\scroll.nes");
-    //rom->Load(".\\roms\\Rockman.nes");
-    //rom->Load(".\\roms\\Millipede.nes");
-    rom->Load(".\\kong.nes");
-
-    SharedPtr<CPU> cpu = std::make_shared<CPU>();
-    SharedPtr<PPU> ppu = std::make_shared<PPU>(cpu.get());
-    SharedPtr<APU> apu = std::make_shared<APU>(cpu.get());
-    cpu->SetPPU(ppu.get());
-    apu->Init();
-    
-    if (!ppu->Init())
+    Console console;
+
+    SDLFrontend frontend(console.GetCPU(), console.GetPPU(), console.GetAPU());
+    if (!frontend.Init())
     {
-        printf("PPU Initialisation failed!");
+        printf("Frontend Initialisation failed!");
         return 0;
     }
-    cpu->Init();
 
     // After initailisation load cartridge
-    cpu->LoadCartridge(rom.get());
+    //console.LoadCartridge(".\\mario.nes");
+    //console.LoadCartridge(".\\scroll.nes");
+    //console.LoadCartridge(".\\roms\\Rockman.nes");
+    //console.LoadCartridge(".\\roms\\Millipede.nes");
+    console.LoadCartridge(argc > 1 ? argv[1] : ".\\kong.nes");
+    console.GetCPU()->SetIdleSkipEnabled(true);
+
+    // Optional second argument is the rewind memory budget in MB, the third the number of frames to run ahead
+    Rewind rewind(argc > 2 ? strtoull(argv[2], nullptr, 10) * 1024 * 1024 : Rewind::DEFAULT_MEMORY_BUDGET);
+    RunAhead runAhead(argc > 3 ? atoi(argv[3]) : 0);
+    uint64 frameCount = 0;
 
     bool bRunning = true;
-    uint prevCPUCycle = 0; 
-    uint cycles = 0;
     double previousTimeElapsed = SDL_GetPerformanceCounter();
     double frameTime = 1.0l / 60.0l;
 
-    uint32_t last_tick_time = 0;
-    uint32_t delta = 0;
-
-    //WaveformGenerator wave;
-    //wave.Init();
-
     while (bRunning)
     {
-        for (uint i = 0; i < 30; ++i)
+        frontend.UpdateInput();
+
+        // Rewinding loads the start of the previous frame & replays it so there is a picture to present, the replayed
+        // frame isn't pushed again so each step goes back one frame. Holds on the oldest frame once the buffer runs out
+        if (frontend.IsRewindHeld())
         {
-            cpu->Update();
-            apu->Update();
+            // Loading & replaying both rewrite the APU, the audio callback mustn't read it part way through
+            frontend.LockAudio();
+            if (rewind.StepBack(console))
+            {
+                console.RunFrame();
+            }
+            frontend.UnlockAudio();
         }
-
-        cycles = cpu->GetCPUCycles() - prevCPUCycle;
-        prevCPUCycle = cpu->GetCPUCycles();
-
-        // 1 cpu cycle = 3 ppu cycles, little hacky for time being.
-        for (uint p = 0; p < cycles * 3; ++p )
+        else
         {
-            ppu->Update();
+            uint skippedFrames = frontend.IsFastForwardHeld() ? FAST_FORWARD_SPEED - 1 : 0;
 
-            if (ppu->GetPPUCycles() == 260)
+            frontend.LockAudio();
+            console.SetRenderEnabled(false);
+            for (uint i = 0; i < skippedFrames; ++i)
             {
-               break;
+                rewind.Push(console);
+                console.RunFrame();
             }
-        }
+            console.SetRenderEnabled(true);
+            frontend.UnlockAudio();
 
-        if (cpu->GetCPUCycles() >= 29780)
-        {
-            double deltaTime = (double)(SDL_GetPerformanceCounter() - previousTimeElapsed) / (double)SDL_GetPerformanceFrequency();
-            previousTimeElapsed = SDL_GetPerformanceCounter();
+            frontend.LockAudio();
+            rewind.Push(console);
+            runAhead.RunFrame(console);
+            frontend.UnlockAudio();
 
-            if (deltaTime < frameTime)
+            // Cost of running ahead every 5 seconds
+            if (runAhead.GetFrames() && ++frameCount % 300 == 0)
             {
-                SDL_Delay((frameTime - deltaTime)*1000);
+                runAhead.PrintStats();
+                runAhead.ResetStats();
             }
+        }
+
+        frontend.Present();
 
-            cpu->ResetCPUCycles();
-            //prevCPUCycle = 0;
+        double deltaTime = (double)(SDL_GetPerformanceCounter() - previousTimeElapsed) / (double)SDL_GetPerformanceFrequency();
+        previousTimeElapsed = SDL_GetPerformanceCounter();
+
+        if (deltaTime < frameTime)
+        {
+            SDL_Delay((frameTime - deltaTime)*1000);
         }
     }
 }
@@ -0,0 +1,181 @@
+#include "SDLFrontend.h"
+#include "CPU.h"
+#include "PPU.h"
+#include "APU.h"
+
+namespace ControlDeck
+{
+	SDLFrontend::SDLFrontend(CPU* cpu, PPU* ppu, APU* apu)
+	{
+		m_cpu = cpu;
+		m_ppu = ppu;
+		m_apu = apu;
+	}
+
+	SDLFrontend::~SDLFrontend()
+	{
+		if (m_audioDevice)
+		{
+			SDL_CloseAudioDevice(m_audioDevice);
+		}
+
+		if (m_sdlSurface)
+		{
+			SDL_FreeSurface(m_sdlSurface);
+		}
+
+		if (m_sdlWindow)
+		{
+			SDL_DestroyWindow(m_sdlWindow);
+		}
+
+		SDL_Quit();
+	}
+
+	bool SDLFrontend::Init()
+	{
+		if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0)
+		{
+			printf("SDL initialisation failed!");
+			return false;
+		}
+
+		m_sdlWindow = SDL_CreateWindow("Control Deck", 0, 0, PPU::FRAME_WIDTH * 3, PPU::FRAME_HEIGHT * 3, SDL_WINDOW_RESIZABLE);
+		m_sdlSurface = SDL_CreateRGBSurface(0, PPU::FRAME_WIDTH, PPU::FRAME_HEIGHT, 32, 0xff0000, 0x00ff00, 0x0000ff, 0x0);
+		SDL_FillRect(m_sdlSurface, NULL, 0x000000);
+		SDL_UpdateWindowSurface(m_sdlWindow);
+
+		SDL_zero(m_audioSpec);
+		m_audioSpec.freq = WaveformGenerator::SAMPLE_RATE;
+		m_audioSpec.format = AUDIO_U8;
+		m_audioSpec.channels = 1;
+		m_audioSpec.silence = 0;
+		m_audioSpec.samples = WaveformGenerator::SAMPLES_PER_BUFFER;
+		m_audioSpec.padding = 0;
+		m_audioSpec.size = 0;
+		m_audioSpec.userdata = this;
+		m_audioSpec.callback = AudioCallback;
+
+		// A device per frontend rather than the legacy SDL_OpenAudio singleton
+		m_audioDevice = SDL_OpenAudioDevice(NULL, 0, &m_audioSpec, NULL, 0);
+		if (m_audioDevice == 0)
+		{
+			printf("Unable to open audio devicve [%s]\n", SDL_GetError());
+			// ignore and continue
+		}
+		else
+		{
+			SDL_PauseAudioDevice(m_audioDevice, 0);
+		}
+
+		return true;
+	}
+
+	void SDLFrontend::AudioCallback(void* userdata, Uint8* stream, int len)
+	{
+		SDLFrontend* frontend = (SDLFrontend*)userdata;
+		frontend->m_apu->GenerateSamples(stream, len);
+	}
+
+	void SDLFrontend::LockAudio()
+	{
+		if (m_audioDevice)
+		{
+			SDL_LockAudioDevice(m_audioDevice);
+		}
+	}
+
+	void SDLFrontend::UnlockAudio()
+	{
+		if (m_audioDevice)
+		{
+			SDL_UnlockAudioDevice(m_audioDevice);
+		}
+	}
+
+	void SDLFrontend::Present()
+	{
+		const std::vector<uint>& frame = m_ppu->GetFrameBuffer();
+
+		SDL_memcpy(m_sdlSurface->pixels, &frame[0], sizeof(Uint32) * frame.size());
+		SDL_BlitScaled(m_sdlSurface, nullptr, SDL_GetWindowSurface(m_sdlWindow), nullptr);
+		SDL_UpdateWindowSurface(m_sdlWindow);
+	}
+
+	void SDLFrontend::UpdateInput()
+	{
+		SDL_Event _event;
+		SDL_Scancode key;
+		const Uint8* keyState = SDL_GetKeyboardState(NULL);
+
+		SDL_PumpEvents();
+		while (SDL_PollEvent(&_event))
+		{
+			if (keyState[SDL_SCANCODE_ESCAPE] || _event.type == SDL_QUIT) {
+			}
+
+			if (_event.type != SDL_KEYDOWN && _event.type != SDL_KEYUP)
+			{
+				continue;
+			}
+
+			bool down = _event.type == SDL_KEYDOWN;
+			key = _event.key.keysym.scancode;
+
+			if (key == SDL_SCANCODE_X)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::A, down);
+			}
+			if (key == SDL_SCANCODE_C)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::B, down);
+			}
+			if (key == SDL_SCANCODE_LEFT)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::LEFT, down);
+			}
+			if (key == SDL_SCANCODE_RIGHT)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::RIGHT, down);
+			}
+			if (key == SDL_SCANCODE_UP)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::UP, down);
+			}
+			if (key == SDL_SCANCODE_DOWN)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::DOWN, down);
+			}
+			if (key == SDL_SCANCODE_RETURN)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::START, down);
+			}
+			if (key == SDL_SCANCODE_0)
+			{
+				m_cpu->SetControllerInput((uint8)Controller::SELECT, down);
+			}
+			if (key == SDL_SCANCODE_BACKSPACE)
+			{
+				m_rewindHeld = down;
+			}
+			if (key == SDL_SCANCODE_TAB)
+			{
+				m_fastForwardHeld = down;
+			}
+		}
+
+#ifdef PSVITA
+		SceCtrlData ctrl;
+		sceCtrlPeekBufferPositive(0, &ctrl, 1);
+
+		m_cpu->SetControllerInput((uint8)Controller::START, ctrl.buttons & SCE_CTRL_START);
+		m_cpu->SetControllerInput((uint8)Controller::SELECT, ctrl.buttons & SCE_CTRL_SELECT);
+		m_cpu->SetControllerInput((uint8)Controller::A, ctrl.buttons & SCE_CTRL_CROSS);
+		m_cpu->SetControllerInput((uint8)Controller::B, ctrl.buttons & SCE_CTRL_CIRCLE);
+		m_cpu->SetControllerInput((uint8)Controller::UP, ctrl.buttons & SCE_CTRL_UP);
+		m_cpu->SetControllerInput((uint8)Controller::DOWN, ctrl.buttons & SCE_CTRL_DOWN);
+		m_cpu->SetControllerInput((uint8)Controller::LEFT, ctrl.buttons & SCE_CTRL_LEFT);
+		m_cpu->SetControllerInput((uint8)Controller::RIGHT, ctrl.buttons & SCE_CTRL_RIGHT);
+#endif
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Common.h"
+#include <SDL2/SDL.h>
+
+namespace ControlDeck
+{
+	class CPU;
+	class PPU;
+	class APU;
+
+	/*	SDL frontend - window, keyboard & audio device on top of the headless core.
+	*	The core only hands over a framebuffer (PPU::GetFrameBuffer), a sample buffer (APU::GenerateSamples) & takes controller input.
+	*/
+	class SDLFrontend
+	{
+	public:
+		SDLFrontend() = delete;
+		SDLFrontend(CPU* cpu, PPU* ppu, APU* apu);
+		~SDLFrontend();
+
+		bool Init();
+
+		//!< Blits the PPU's last completed frame to the window
+		void Present();
+
+		//!< Polls SDL events & forwards key presses to controller 1
+		void UpdateInput();
+
+		//!< Keeps the audio callback out of the APU, e.g. while run ahead frames change it speculatively
+		void LockAudio();
+		void UnlockAudio();
+
+		//!< Backspace held, the main loop steps back through the rewind buffer instead of running forwards
+		bool IsRewindHeld() const { return m_rewindHeld; }
+
+		//!< Tab held, the main loop runs several frames per tick & only draws the last
+		bool IsFastForwardHeld() const { return m_fastForwardHeld; }
+
+	private:
+		static void AudioCallback(void* userdata, Uint8* stream, int len);
+
+		CPU* m_cpu = nullptr;
+		PPU* m_ppu = nullptr;
+		APU* m_apu = nullptr;
+
+		SDL_Window* m_sdlWindow = nullptr;
+		SDL_Surface* m_sdlSurface = nullptr;
+		SDL_AudioSpec m_audioSpec;
+		SDL_AudioDeviceID m_audioDevice = 0;
+
+		bool m_rewindHeld = false;
+		bool m_fastForwardHeld = false;
+	};
+}
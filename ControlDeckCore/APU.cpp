@@ -0,0 +1,98 @@
+#include "APU.h"
+
+ControlDeck::APU::APU(CPU* cpu)
+{
+	m_cpu = cpu;
+}
+
+void ControlDeck::APU::Init()
+{
+	//m_triangleWave.Init(WaveformType::TRIANGLE);
+	m_pulse1.Init(WaveformType::PULSE);
+	//m_pulse2.Init(WaveformType::PULSE);
+}
+
+void ControlDeck::APU::GenerateSamples(uint8* stream, int len)
+{
+	m_pulse1.Generate(stream, len);
+}
+
+void ControlDeck::APU::WriteRegister(uint16 Addr, uint8 data)
+{
+	m_registers[Addr - PULSE1_DUTY_ENVELOPE_WRITE] = data;
+	m_registersDirty = true;
+}
+
+void ControlDeck::APU::CatchUp(uint64 masterClock)
+{
+	// Channels only change on register writes at present, frame counter/ length counter clocking would be run up to masterClock here
+	m_timestamp = masterClock;
+	Update();
+}
+
+void ControlDeck::APU::Update()
+{
+	if (!m_registersDirty)
+	{
+		return;
+	}
+
+	m_registersDirty = false;
+
+	const float apuClock = 1790000.0f;  // 1.79 MHz in Hz
+
+	// Update triangle wave
+	uint8 timerHighMask = 0x7; // Mask high bits timer high ---- -HHH 
+	uint16 highByte = GetRegister(APU_TRIANGLE_COUNTER_RELOAD_TIMER_HIGH) & timerHighMask;
+	highByte = highByte << 8;
+	uint16 lowByte = GetRegister(APU_TRIANGLE_TIMER);
+	int frequency = (0x1000 - (highByte | lowByte));
+
+	if (frequency == 0)
+	{
+		return;
+	}
+
+	m_triangleWave.SetHertz(apuClock/(float)frequency);
+
+	// Update PULSE 
+
+
+	uint8 pulse1Sweep = GetRegister(PULSE1_SWEEP);
+	m_pulse1.SetDuty((DUTY_CYCLE_MASK & GetRegister(PULSE1_DUTY_ENVELOPE_WRITE)) >> 6);
+	int pulse1ShiftCount = GetRegister(PULSE1_SWEEP) & SHIFT_COUNT_MASK;
+	bool pulse1Negate = GetRegister(PULSE1_SWEEP) & NEGATE_MASK;
+	bool pulse1Volume = GetRegister(PULSE1_DUTY_ENVELOPE_WRITE) & VOLUME_MASK;
+
+	highByte = GetRegister(PULSE1_COUNTER_TIMER_HIGH) & timerHighMask;
+	highByte = highByte << 8;
+	lowByte = GetRegister(PULSE1_TIMER_LOW);
+	frequency = (highByte | lowByte);
+	int frequencyModulation = frequency >> pulse1ShiftCount;
+	frequency += pulse1Negate ? -frequencyModulation : frequencyModulation;
+	//m_pulse1.SetHertz(apuClock / (float)frequency);
+	m_pulse1.SetHertz(frequency);
+	m_pulse1.SetVolume(pulse1Volume);
+
+	bool sweepEnabled = (0x80 & GetRegister(PULSE1_SWEEP));
+
+	if (pulse1ShiftCount == 0 || pulse1Volume == 0)
+	{
+		m_pulse1.SetMute(true);
+	}
+	else
+	{
+		m_pulse1.SetMute(false);
+	}
+
+	// Update PULSE 
+	highByte = GetRegister(PULSE2_COUNTER_TIMER_HIGH) & timerHighMask;
+	//highByte = 0;
+	highByte = highByte << 8;
+	lowByte = GetRegister(PULSE2_TIMER_LOW);
+	frequency = ((highByte | lowByte));
+	m_pulse2.SetHertz(apuClock / (float)frequency);
+
+	m_pulse2.SetDuty((DUTY_CYCLE_MASK & GetRegister(PULSE2_DUTY_ENVELOPE_WRITE)) >> 6);
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "Types.h"
+#include "WaveformGenerator.h"
+#include "CPU.h"
+
+namespace ControlDeck
+{
+	/*	APUState - latched registers & channel state, a plain struct so it can be copied in one go
+	*/
+	struct APUState
+	{
+		//!< Master clock time the APU has been brought up to
+		uint64 m_timestamp = 0;
+
+		//!< Latched APU registers $4000 - $4017, m_registersDirty is set by a write until the next Update()
+		std::array<uint8, 0x18> m_registers = {};
+		bool m_registersDirty = true;
+
+		//!< Explicit padding, see the static_assert below
+		uint8 m_reserved[7] = {};
+
+		WaveformGenerator m_triangleWave;
+		WaveformGenerator m_pulse1;
+		WaveformGenerator m_pulse2;
+	};
+
+	//!< No padding bytes - the float channel fields rule out has_unique_object_representations, so check the packed size
+	static_assert(sizeof(WaveformGenerator) == 8 * 4, "WaveformGenerator has padding");
+	static_assert(sizeof(APUState) == 8 + 0x18 + 8 + 3 * sizeof(WaveformGenerator), "APUState has padding");
+
+	/* APU - Audio Processing Unit
+	* 
+	*/
+	class APU : private APUState
+	{
+	public:
+		APU() = delete; 
+		APU(CPU* cpu);
+
+		void Init();
+
+		//!< Applies latched register writes to the channels, nothing to do when nothing was written since the last update
+		void Update();
+
+		//!< Brings the APU up to masterClock, called once per scheduler slice rather than per instruction
+		void CatchUp(uint64 masterClock);
+
+		//!< Latches a CPU write to $4000 - $4017, see CPU::WriteIORegister
+		void WriteRegister(uint16 Addr, uint8 data);
+
+		//!< Sample buffer for the frontend, len unsigned 8 bit mono samples at WaveformGenerator::SAMPLE_RATE - only pulse 1 is mixed at present
+		//!< Called from the audio thread, stream is left untouched while the channel is muted
+		void GenerateSamples(uint8* stream, int len);
+
+		const APUState& GetState() const { return *this; }
+		void SetState(const APUState& state) { static_cast<APUState&>(*this) = state; }
+
+		/*APU Registers
+		* see https://www.nesdev.org/wiki/APU#Pulse_($4000-4007)	
+		* 
+		* Pulse 1 $4000 - $4003
+		* Pulse 2 $4004 - $4007
+		* Triangle 4008 - $400B
+		* Noise $400C$400F
+		* DMC $4010$4013
+		* $4015 (All channels) channel enable and length counter status.
+		* $4017 (All channels) frame counter.
+		*/
+
+		/* Pulse 1 Channel(write) $4000 - $4003
+		* $4000/ $4004 - Duty & envelope/volume (write) DDLC VVVV
+		* Duty (D), envelope loop / length counter halt (L), constant volume (C), volume/envelope (V)*/
+		static const uint16 PULSE1_DUTY_ENVELOPE_WRITE = 0x4000;
+		static const uint16 PULSE1_SWEEP = 0x4001;
+		static const uint16 PULSE1_TIMER_LOW = 0x4002;
+		static const uint16 PULSE1_COUNTER_TIMER_HIGH = 0x4003;
+
+		static const uint16 PULSE2_TIMER_LOW = 0x4006;
+		static const uint16 PULSE2_COUNTER_TIMER_HIGH = 0x4007;
+
+		static const uint16 PULSE2_DUTY_ENVELOPE_WRITE = 0x4004;
+
+		// Triangle 
+		static const uint16 APU_TRIANGLE_COUNTER = 0x4008;
+		static const uint16 APU_TRIANGLE_TIMER = 0x400A;
+		static const uint16 APU_TRIANGLE_COUNTER_RELOAD_TIMER_HIGH = 0x400B;
+
+		const uint8 DUTY_CYCLE_MASK = 0xC0;
+		const uint8 SHIFT_COUNT_MASK = 0x7;
+		const uint8 NEGATE_MASK = 0x8;
+		const uint8 VOLUME_MASK = 0x15;
+		
+	private:
+		CPU* m_cpu;
+
+		uint8 GetRegister(uint16 Addr) const { return m_registers[Addr - PULSE1_DUTY_ENVELOPE_WRITE]; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,1276 @@
+// Copyright  Allan Moore April 2020
+// Author Allan Moore 20/ 03/ 2015 - April 2020
+
+#include "CPU.h"
+#include "APU.h"
+#include "PPUCtrl.h"
+#include "AddressingMode.h"
+
+//#define DEBUG_PRINT
+
+namespace ControlDeck {
+
+	CPU::CPU()
+	{
+		//!< The 6502 uses a 16 bit address bus $0 - $FFFF ($FFFF+1 possible addresses), backing memory is zero initialised
+		MapMemory();
+	}
+
+	void CPU::Init()
+	{
+		//!< Opcode metadata is static, see INSTRUCTION_TABLE in Instruction.h
+	}
+
+	void CPU::CheckForInterrupt()
+	{
+		if (ProcessorStatus & (uint8)PFlags::INTERRUPT_DISABLED)
+		{
+			//return;
+		}
+
+		// Straight from the register copy - a bus read would sync the PPU before every instruction. m_nmi is set by the
+		// PPU's vblank event, which ends the run slice, so it's never behind here
+		uint8 ppuCtrl = m_ppuRegisters[PPU_CTRL_ADR & PPU_REGISTER_MASK];
+
+		// if bit 7 set of ppu ctrl skip nmi. 
+		// if (ppuCtrl & (uint8)PPUCtrl::VerticalBlanking)
+		if (m_nmi && (ppuCtrl & (uint8)PPUCtrl::VerticalBlanking))
+		{
+			PushStack16(PC);
+			PushStack8(GetProcessorStatus());
+			PC = ReadMemory16(0xFFFA);
+			m_nmi = false;
+		}
+	}
+
+	void CPU::DebugOutput()
+	{
+	}
+
+	void CPU::Update()
+	{
+		// Check for non-maskable interrupt
+		CheckForInterrupt();
+
+		if (m_idleSkipEnabled)
+		{
+			StepIdleSkip();
+			return;
+		}
+
+		Step();
+	}
+
+	uint32 CPU::Run(uint32 cycles, uint64 masterClock)
+	{
+		uint32 start = m_cycleCounter;
+		m_runTarget = start + cycles;
+		m_runStartCycle = start;
+		m_runMasterClock = masterClock;
+		m_running = true;
+
+		while (m_cycleCounter - start < cycles)
+		{
+			Update();
+		}
+
+		m_running = false;
+		return m_cycleCounter - start;
+	}
+
+	void CPU::SyncPPU()
+	{
+		if (m_running)
+		{
+			m_ppu->CatchUp(m_runMasterClock + ((uint64)(m_cycleCounter - m_runStartCycle) * MASTER_CLOCK_DIVIDER));
+		}
+	}
+
+	void CPU::Step()
+	{
+		// Back onto blocks at the next address one starts at
+		if (m_finishingBlock && PC >= PRGROM_LOWER && (IsBlockStart(PC) || IsJITBlockStart(PC)))
+		{
+			m_finishingBlock = false;
+		}
+
+		if ((m_jitEnabled || m_blockCacheEnabled) && PC >= PRGROM_LOWER && !m_finishingBlock)
+		{
+			if (m_jitEnabled && ExecuteJIT())
+			{
+				return;
+			}
+
+			if (m_blockCacheEnabled)
+			{
+				ExecuteBlock();
+				return;
+			}
+		}
+
+		uint8 opCode = ReadMemory8(PC);
+
+		if (m_finishingBlock && EndsBlock(opCode))
+		{
+			m_finishingBlock = false;
+		}
+
+		Execute(opCode);
+	}
+
+	void CPU::Execute(uint8 opCode)
+	{
+		const InstructionInfo& info = INSTRUCTION_TABLE[opCode];
+		m_instructionCount++;
+
+#ifdef DEBUG_PRINT
+		uint8 byte1 = ReadMemory8(PC + 1);
+		uint8 byte2 = ReadMemory8(PC + 2);
+
+		if (info.Bytes == 1)
+		{
+			printf("%04X %02X       %s\t\t", PC, opCode, info.Name);
+		}
+		else if (info.Bytes == 2)
+		{
+			printf("%04X %02X %02X    %s\t\t", PC, opCode, byte1, info.Name);
+		}
+		else
+		{
+			printf("%04X %02X %02X %02X %s\t\t", PC, opCode, byte1, byte2, info.Name);
+		}
+
+		printf("A:%02X X:%02X Y:%02X P:%02X SP:%02X\n", Accumulator, XReg, YReg, GetProcessorStatus(), SP);
+#endif
+
+		// Direct dispatch, one case per opcode generated from the opcode table
+		switch (opCode)
+		{
+#define CONTROLDECK_OPCODE_CASE(opCode, name, handler, mode, bytes, cycles, cyclesPage) \
+		case opCode: handler<AdrMode::mode>(); break;
+			CONTROLDECK_OPCODES(CONTROLDECK_OPCODE_CASE)
+#undef CONTROLDECK_OPCODE_CASE
+		default:
+			throw("Not implemented");
+		}
+
+		m_cycleCounter += info.Cycles;
+	}
+
+	const std::array<CPU::OpHandler, 0x100> CPU::HANDLER_TABLE = []()
+	{
+		std::array<CPU::OpHandler, 0x100> table = {};
+
+#define CONTROLDECK_OPCODE_HANDLER(opCode, name, handler, mode, bytes, cycles, cyclesPage) \
+		table[opCode] = &CPU::handler<AdrMode::mode>;
+		CONTROLDECK_OPCODES(CONTROLDECK_OPCODE_HANDLER)
+#undef CONTROLDECK_OPCODE_HANDLER
+
+		return table;
+	}();
+
+	const std::array<CPU::FusedInstruction, FUSED_PAIR_COUNT> CPU::FUSED_TABLE = {{
+#define CONTROLDECK_FUSED_PAIR(first, firstHandler, firstMode, second, secondHandler, secondMode) \
+		{ first, second, &CPU::FusedPair<&CPU::firstHandler<AdrMode::firstMode>, INSTRUCTION_TABLE[first].Cycles, &CPU::secondHandler<AdrMode::secondMode>> },
+		CONTROLDECK_FUSED_PAIRS(CONTROLDECK_FUSED_PAIR)
+#undef CONTROLDECK_FUSED_PAIR
+	}};
+
+	void CPU::SetControllerInput(uint8 input, bool down)
+	{
+		if (down)
+		{
+			m_controller1Input |= input;
+		}
+		else
+		{
+			m_controller1Input &= ~input;
+		}
+	}
+
+	void CPU::LoadCartridge(Cartridge* cartridge)
+	{
+		// Does not support dynamic bank loading at present, games with more than 2 banks will not work
+		m_loadedCartridge = cartridge;
+
+		// Default - Load the first rom bank into $8000 and last rom bank into $C000
+		const std::vector<uint8>& bank0 = cartridge->GetPRGRomBank(0);
+		const std::vector<uint8>& bank1 = cartridge->GetPRGRomBank(cartridge->GetNumPRGRomBanks() - 1);
+
+		// Map banks to PRGROM, reads come straight from the cartridge
+		for (uint page = 0; page < 0x40; ++page)
+		{
+			m_readPages[(PRGROM_LOWER >> 8) + page] = &bank0[page << 8];
+			m_readPages[(PRGROM_UPPER >> 8) + page] = &bank1[page << 8];
+		}
+
+		// load pattern tables into PPU
+		if (cartridge->GetNumVRamBanks() > 0)
+		{
+			const std::vector<uint8> vrambank0 = cartridge->GetCHRBank(0);
+
+			for (int i = 0; i < vrambank0.size(); ++i)
+			{
+				m_ppu->WriteMemory8(i, vrambank0[i]);
+			}
+		}
+
+		if (cartridge->GetNumVRamBanks() > 1)
+		{
+			const std::vector<uint8> vrambank1 = cartridge->GetCHRBank(1);
+
+			for (int i = 0; i < vrambank1.size(); ++i)
+			{
+				m_ppu->WriteMemory8(0x1FFF + i, vrambank1[i]);
+			}
+		}
+
+		// Banks changed, drop any decoded & compiled blocks
+		InvalidateBlocks();
+		InvalidateJIT();
+		InvalidateIdleLoops();
+
+		// Set the program counter to the reset vector 
+		PC = ReadMemory16(0xFFFC);
+	}
+
+	void CPU::SetProcessorFlag(PFlags Flag, bool bEnabled)
+	{
+		if (bEnabled)
+		{
+			ProcessorStatus |= (uint8)Flag;
+		}
+		else
+		{
+			ProcessorStatus &= ~((uint8)Flag);
+		}
+	}
+
+	void CPU::SetProcessorStatus(uint8 status)
+	{
+		ProcessorStatus = status;
+		m_zeroResult = (status & PFlags::ZERO) ? 0 : 1;
+		m_negativeResult = status;
+	}
+
+	/** CPU MEMORY READ & WRITE **/
+	void CPU::MapMemory()
+	{
+		for (uint page = 0; page < 0x100; ++page)
+		{
+			m_readPages[page] = nullptr;
+			m_writePages[page] = nullptr;
+
+			if (page < 0x20)
+			{
+				// Internal RAM, $0000-$07FF mirrored at $0800, $1000, $1800 - equivalent to Addr & WORK_RAM_MASK
+				uint8* memory = &m_workRAM[(page << 8) & WORK_RAM_MASK];
+				m_readPages[page] = memory;
+				m_writePages[page] = memory;
+			}
+			else if (page < 0x40)
+			{
+				// PPU registers $2000-$2007, mirrored every 8 bytes to $3FFF
+				m_readHandlers[page] = &CPU::ReadPPURegister;
+				m_writeHandlers[page] = &CPU::WritePPURegister;
+			}
+			else if (page == 0x40)
+			{
+				// APU, OAM DMA & controller registers
+				m_readHandlers[page] = &CPU::ReadIORegister;
+				m_writeHandlers[page] = &CPU::WriteIORegister;
+			}
+			else if (page >= 0x60 && page < 0x80)
+			{
+				// SRAM
+				uint8* memory = &m_sram[(page - 0x60) << 8];
+				m_readPages[page] = memory;
+				m_writePages[page] = memory;
+			}
+			else
+			{
+				// Expansion ROM & PRG-ROM, PRG-ROM pages are mapped when a cartridge is loaded
+				m_readHandlers[page] = &CPU::ReadOpenBus;
+				m_writeHandlers[page] = &CPU::WriteROM;
+			}
+		}
+	}
+
+	uint8 CPU::ReadOpenBus(uint16 /*Addr*/)
+	{
+		return 0;
+	}
+
+	void CPU::WriteROM(uint16 /*Addr*/, uint8 /*data*/)
+	{
+		// Read only, no mapper registers supported at present - a mapper bank switch here must call InvalidateBlocks(), InvalidateJIT() & InvalidateIdleLoops()
+	}
+
+	void CPU::WritePPURegister(uint16 Addr, uint8 data)
+	{
+		//!< Registers $2000-$2007 are mirrored every 8 bytes in the range $2008-$3FFF
+		Addr = PPU_CTRL_ADR | (Addr & PPU_REGISTER_MASK);
+		SyncPPU();
+
+		if (m_startup)
+		{
+			if (m_cycleCounter < 29658)
+			{
+				if (Addr == PPU_DATA_ADR || Addr == PPU_MASK_ADR || Addr == PPU_COARSE_SCROLL_ADR || Addr == PPU_SCROLL_ADR)
+				{
+					return;
+				}
+			}
+		}
+
+		if (Addr == 0x2002 || Addr == 0x2003)
+		{
+			m_ppuRegisters[PPU_STATUS_ADR & PPU_REGISTER_MASK] = (m_ppuRegisters[PPU_STATUS_ADR & PPU_REGISTER_MASK] & 0x1F) | (data & 0xE0);
+		}
+		// Write lsb of data previous written into PPU registers into ppu status $2002 register
+		else if (Addr >= PPU_CTRL_ADR && Addr < 0x2005)
+		{
+			// Write lsb (5 bits) into PPUSTATUS register $2002
+			//RAM[PPU_STATUS_ADR] = (RAM[PPU_STATUS_ADR] & 0xE0) | (Data & 0x1F);
+			m_ppuRegisters[PPU_STATUS_ADR & PPU_REGISTER_MASK] |= data;
+
+			// PPUMASK is picked up for the emphasis & greyscale palettes
+			if (Addr == 0x2000 || Addr == PPU_MASK_ADR)
+			{
+				m_ppuRegisters[Addr & PPU_REGISTER_MASK] = data;
+			}
+
+			//if (Addr == 0x2007 || Addr == 0x2006 || Addr == 0x2005)
+			//{
+			//	RAM[Addr] = Data;
+			//}
+		}
+		else
+		{
+			m_ppuRegisters[Addr & PPU_REGISTER_MASK] = data;
+		}
+
+		// Write to PPUDATA $2700 - VRAM Address incremented by bit 2 of $2000 (cpu ctrl address) after read/ write
+		if (Addr == PPU_DATA_ADR)// || Addr == PPU_SCROLL_ADR) // maybe not
+		{
+			m_ppu->WriteMemory8(m_vramAddress, data);
+
+			uint8 incrememnt = (m_ppuRegisters[PPU_CTRL_ADR & PPU_REGISTER_MASK] & (uint8)PPUCtrl::VRamAddressIncrement);
+			if (incrememnt)
+			{
+				// Plus 32 to address 
+				m_vramAddress += 32;
+			}
+			else
+			{
+				// Plus 1 to address
+				m_vramAddress++;
+			}
+		}
+
+		if (Addr == PPU_SCROLL_ADR)
+		{
+			if (m_scrollFirstWrite)
+			{
+				m_ppu->m_scrollX = 0xE0 & data;
+			}
+			else
+			{
+				m_ppu->m_scrollY = 0xE0 & data;
+			}
+
+			printf("%i\n", m_ppu->m_scrollX);
+
+			m_scrollFirstWrite = !m_scrollFirstWrite;
+		}
+
+		// Write OAM Address 
+		if (Addr == OAM_ADR)
+		{
+			m_oamAddress = data;
+		}
+
+		// Writes to OAM data $2004, increment OAMADDR after the write, reads during vertial or forced blanking return the value but don't increment
+		if (Addr == OAM_DATA_ADR)
+		{
+			m_ppu->WriteOAMByte(m_oamAddress, data);
+			m_oamAddress++;
+		}
+
+		// $2006/ $2005? maybe not
+		if (Addr == PPU_COARSE_SCROLL_ADR)// || Addr == PPU_SCROLL_ADR)
+		{
+			if (!m_vramToggle)
+			{
+				m_vramAddress = (uint16)data << 8;
+			
+				//Lower 5 bits.
+				m_ppu->m_scrollX = 0x1F & data;
+				
+				// upper 3 bits.
+				m_ppu->m_scrollY = 0xE0 & data;
+				//
+				//printf("%i\n", m_ppu->m_coarseX);
+			}
+			else
+			{
+				m_vramAddress |= data;
+			}
+
+			m_vramToggle = !m_vramToggle;
+		}
+	}
+
+	void CPU::WriteIORegister(uint16 Addr, uint8 data)
+	{
+		if (Addr == CONTROLLER1_ADR)
+		{
+			if (data == 0x1)
+			{
+				m_controllerLatched = true;
+			}
+		}
+
+		// APU registers are latched, the APU picks them up next time it is updated
+		if (m_apu && (Addr < OAM_DMA_ADR || Addr == 0x4015 || Addr == 0x4017))
+		{
+			m_apu->WriteRegister(Addr, data);
+		}
+
+		// OAM DMA $4014 - Initialise DMA
+		if (Addr == OAM_DMA_ADR)
+		{
+			SyncPPU();
+
+			// Write lsb of data previous written into PPU registers into ppu status $2002 register
+			m_ppuRegisters[PPU_STATUS_ADR & PPU_REGISTER_MASK] |= data;
+
+			uint16 start = 0x100 * data;
+			for (uint offset = 0; offset <= 0xFF; ++offset)
+			{
+				m_ppu->WriteOAMByte(offset, ReadMemory8(start + offset));
+			}
+
+			m_cycleCounter += 513;
+			m_cycleCounter += m_cycleCounter % 2;
+			m_oamAddress = 0xFF;
+			return;
+		}
+
+		if (Addr < 0x4020)
+		{
+			m_ioRegisters[Addr & 0x1F] = data;
+		}
+	}
+
+	uint8 CPU::ReadIORegister(uint16 Addr)
+	{
+		if (Addr == CONTROLLER1_ADR || Addr == CONTROLLER2_ADR)
+		{
+			if (m_controllerLatched)
+			{
+				uint8 input = (Addr == CONTROLLER1_ADR) ? m_controller1Input : m_controller2Input;
+
+				// read input 1 bit at time and increment 
+				input = (input >> m_controllerReadBit) & 0x1;
+				m_controllerReadBit++;
+
+				if (m_controllerReadBit >= 8)
+				{
+					m_controllerReadBit = 0;
+
+					if (Addr == CONTROLLER2_ADR)
+					{
+						m_controllerLatched = false;
+					}
+				}
+				//WriteMemory8(Addr, input);
+				return input;
+			}
+		}
+
+		if (Addr < 0x4020)
+		{
+			return m_ioRegisters[Addr & 0x1F];
+		}
+
+		return ReadOpenBus(Addr);
+	}
+
+	uint8 CPU::ReadPPURegister(uint16 Addr)
+	{
+		//!< Registers $2000-$2007 are mirrored every 8 bytes in the range $2008-$3FFF
+		Addr = PPU_CTRL_ADR | (Addr & PPU_REGISTER_MASK);
+		SyncPPU();
+
+		if (Addr == PPU_DATA_ADR || Addr == PPU_SCROLL_ADR)
+		{
+			uint8 data = m_ppu->ReadMemory8(m_vramAddress, true);
+
+			uint8 incrememnt = (m_ppuRegisters[PPU_CTRL_ADR & PPU_REGISTER_MASK] & (uint8)PPUCtrl::VRamAddressIncrement);
+			if (incrememnt)
+			{
+				// Plus 32 to address 
+				m_vramAddress += 32;
+			}
+			else
+			{
+				// Plus 1 to address
+				m_vramAddress++;
+			}
+
+			return data;
+		}
+
+		// When a read from $2002 occurs, bit 7 is reset to 0 as are $2005 and $2006.
+		if (Addr == PPU_STATUS_ADR)
+		{
+			//RAM[PPU_STATUS_ADR] &= ~(uint8)PPUStatus::VerticalBlank;
+			////RAM[PPU_STATUS_ADR] &= ~(uint8)PPUStatus::Sprite0Hit;
+			//RAM[0x2005] = 0;
+			//RAM[0x2006] = 0;
+			m_vramToggle = false;
+			m_scrollFirstWrite = false;
+		}
+
+		return m_ppuRegisters[Addr & PPU_REGISTER_MASK];
+	}
+
+	uint16 CPU::ReadMemory16(uint16 Addr)
+	{
+		uint16 mem = ReadMemory8(Addr);
+		mem |= (ReadMemory8(Addr + 1) << 8);
+		return mem;
+	}
+
+	void CPU::PushStack8(uint8 memory)
+	{
+		WriteMemory8(STACK + SP, memory);
+		DecrementSP();
+	}
+
+	void CPU::PushStack16(uint16 memory)
+	{
+		// Push high, low 
+		PushStack8(memory >> 8);
+		PushStack8(memory);
+	}
+
+	uint8 CPU::PopStack8()
+	{
+		IncrementSP();
+		return ReadMemory8(STACK + SP);
+	}
+
+	uint16 CPU::PopStack16()
+	{
+		// pop low - high
+		uint16 low = PopStack8();
+		uint16 high = PopStack8() << 8;
+		return high | low;
+	}
+
+	/** ======================= **/
+
+#pragma region _6502_Instructions 
+
+#pragma region Implied Addressing Mode Instructions
+/***Implied Addressing Mode Instructions (25)***/
+	template <AdrMode Mode>
+	void CPU::BRK_$00()
+	{
+		PushStack16(PC);
+		PushStack8(GetProcessorStatus());
+		SetProcessorFlag(PFlags::BRK_CMD, true);
+		PC = ReadMemory16(0xFFFE);
+	}
+	template <AdrMode Mode>
+	void CPU::CLC_$18()
+	{
+		SetProcessorFlag(PFlags::CARRY, false);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::CLD_$D8()
+	{
+		SetProcessorFlag(PFlags::DECIMAL_MODE, false);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::CLI_$58()
+	{
+		SetProcessorFlag(PFlags::INTERRUPT_DISABLED, false);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::CLV_$B8()
+	{
+		SetProcessorFlag(PFlags::OVER_FLOW, false);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::DEX_$CA()
+	{
+		XReg--;
+		SetResultFlags(XReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::DEY_$88()
+	{
+		YReg--;
+		SetResultFlags(YReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::INX_$E8()
+	{
+		XReg++;
+		SetResultFlags(XReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::INY_$C8()
+	{
+		YReg++;
+		SetResultFlags(YReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::NOP_$EA()
+	{
+		//!< Does nothing 
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::PHA_$48()
+	{
+		PushStack8(Accumulator);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::PHP_$08()
+	{
+		PushStack8(GetProcessorStatus());
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::PLA_$68()
+	{
+		Accumulator = PopStack8();
+		SetResultFlags(Accumulator);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::PLP_$28()
+	{
+		SetProcessorStatus(PopStack8());
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::RTI_$40()
+	{
+		SetProcessorStatus(PopStack8());
+		PC = PopStack16();
+	}
+	template <AdrMode Mode>
+	void CPU::JSR_$20()
+	{
+		PC++;
+		uint16 jmpAdr = ReadMemory16(PC);
+		PushStack16(PC + 1);
+		PC = jmpAdr;
+	}
+	template <AdrMode Mode>
+	void CPU::RTS_$60()
+	{
+		this->PC = PopStack16() + 1;
+	}
+	template <AdrMode Mode>
+	void CPU::SEC_$38()
+	{
+		this->ProcessorStatus |= PFlags::CARRY;
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::SED_$f8() {
+		this->ProcessorStatus |= PFlags::DECIMAL_MODE;
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::SEI_$78() {
+		this->ProcessorStatus |= PFlags::INTERRUPT_DISABLED;
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::TAX_$AA()
+	{
+		XReg = Accumulator;
+		SetResultFlags(XReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::TAY_$A8() {
+		YReg = Accumulator;
+		SetResultFlags(YReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::TSX_$BA() {
+		this->XReg = this->SP;
+		SetResultFlags(XReg);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::TXA_$8A() {
+		this->Accumulator = this->XReg;
+		SetResultFlags(Accumulator);
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::TXS_$9A()
+	{
+		this->SP = this->XReg;
+		PC++;
+	}
+	template <AdrMode Mode>
+	void CPU::TYA_$98() {
+		this->Accumulator = this->YReg;
+		SetResultFlags(Accumulator);
+		PC++;
+	}
+#pragma endregion Implied Mode
+
+#pragma region Add memory to accumulator with carry
+	/*Add memory to Accumulator with carry*/
+	template <AdrMode Mode>
+	void CPU::ADC()
+	{
+		uint8 data = ReadMemory8(ReadMemoryAddress<Mode>());
+
+		uint16 sum = ProcessorStatus & PFlags::CARRY;
+		sum += Accumulator;
+		sum += data;
+
+		// check for overflow. 
+		if (data & PFlags::NEGATIVE && Accumulator & PFlags::NEGATIVE)
+		{
+			SetProcessorFlag(PFlags::OVER_FLOW, (sum & PFlags::NEGATIVE) == 0);
+		}
+
+		// check for overflow.
+		if ((data & PFlags::NEGATIVE) == 0 && (Accumulator & PFlags::NEGATIVE) == 0)
+		{
+			SetProcessorFlag(PFlags::OVER_FLOW, sum & PFlags::NEGATIVE);
+		}
+
+		SetProcessorFlag(PFlags::CARRY, sum > 255);
+
+		// Zero is taken from the full 16 bit sum
+		m_zeroResult = (uint8)sum | (uint8)(sum >> 8);
+		m_negativeResult = (uint8)sum;
+
+		Accumulator = sum;
+	}
+
+#pragma endregion ADC - Add with carry
+
+#pragma region Bitwise AND with acumulator
+	/*AND - Bitwsie AND */
+	template <AdrMode Mode>
+	void CPU::AND()
+	{
+		uint8 data = ReadMemory8(ReadMemoryAddress<Mode>());
+		Accumulator &= data;
+
+		SetResultFlags(Accumulator);
+	}
+#pragma endregion
+
+	/*ASL - Arithmetic Shift Left*/
+	template <AdrMode Mode>
+	void CPU::ASL()
+	{
+		uint8 data = 0;
+
+		if constexpr (Mode == AdrMode::ACCUMULATOR)
+		{
+			PC++;
+			SetProcessorFlag(PFlags::CARRY, (Accumulator & PFlags::NEGATIVE));
+			Accumulator = Accumulator << 1;
+			data = Accumulator;
+		}
+		else
+		{
+			uint16 adr = ReadMemoryAddress<Mode>();
+			data = ReadMemory8(adr);
+			SetProcessorFlag(PFlags::CARRY, (data & PFlags::NEGATIVE));
+			data = data << 1;
+			WriteMemory8(adr, data);
+		}
+
+		SetResultFlags(data);
+	}
+
+	/*BIT - Check if bit set in memory location*/
+	template <AdrMode Mode>
+	void CPU::BIT()
+	{
+		uint16 adr = ReadMemoryAddress<Mode>();
+		uint8 data = ReadMemory8(adr);
+
+		m_zeroResult = data & Accumulator;
+		m_negativeResult = data;
+		SetProcessorFlag(PFlags::OVER_FLOW, data & PFlags::OVER_FLOW);
+	}
+
+	template <AdrMode Mode>
+	void CPU::CMP()
+	{
+		// Used to determine if value in memory is less than, greater than or equal to value in accumulator
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		SetProcessorFlag(PFlags::CARRY, Accumulator >= memory);
+		SetResultFlags(Accumulator - memory);
+	}
+
+	template <AdrMode Mode>
+	void CPU::CPX()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		SetProcessorFlag(PFlags::CARRY, XReg >= memory);
+		SetResultFlags(XReg - memory);
+	}
+
+	template <AdrMode Mode>
+	void CPU::CPY()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		SetProcessorFlag(PFlags::CARRY, YReg >= memory);
+		SetResultFlags(YReg - memory);
+	}
+
+	template <AdrMode Mode>
+	void CPU::DEC()
+	{
+		uint16 adr = ReadMemoryAddress<Mode>();
+		uint8 data = ReadMemory8(adr);
+		data--;
+		WriteMemory8(adr, data);
+		SetResultFlags(data);
+	}
+
+	template <AdrMode Mode>
+	void CPU::EOR()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		Accumulator ^= memory;
+		SetResultFlags(Accumulator);
+	}
+
+	template <AdrMode Mode>
+	void CPU::INC()
+	{
+		uint16 adr = ReadMemoryAddress<Mode>();
+		uint8 data = ReadMemory8(adr);
+		data++;
+		WriteMemory8(adr, data);
+		SetResultFlags(data);
+	}
+
+	template <AdrMode Mode>
+	void CPU::JMP()
+	{
+		PC = ReadMemoryAddress<Mode>();
+	}
+
+	template <AdrMode Mode>
+	void CPU::ORA()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		Accumulator |= memory;
+		SetResultFlags(Accumulator);
+	}
+
+	template <AdrMode Mode>
+	void CPU::ROL()
+	{
+		uint8 data = 0;
+		uint8 carry = (ProcessorStatus & PFlags::CARRY) ? 0x01 : 0;
+
+		if constexpr (Mode == AdrMode::ACCUMULATOR)
+		{
+			PC++;
+			SetProcessorFlag(PFlags::CARRY, (Accumulator & PFlags::NEGATIVE));
+			Accumulator = Accumulator << 1;
+			Accumulator |= carry;
+			data = Accumulator;
+		}
+		else
+		{
+			uint16 adr = ReadMemoryAddress<Mode>();
+			data = ReadMemory8(adr);
+			SetProcessorFlag(PFlags::CARRY, (data & PFlags::NEGATIVE));
+			data = data << 1;
+			Accumulator |= carry;
+			WriteMemory8(adr, data);
+		}
+
+		SetResultFlags(data);
+	}
+
+	template <AdrMode Mode>
+	void CPU::ROR()
+	{
+		uint8 data = 0;
+		uint8 carry = (ProcessorStatus & PFlags::CARRY) ? 0x80 : 0;
+
+		if constexpr (Mode == AdrMode::ACCUMULATOR)
+		{
+			PC++;
+			SetProcessorFlag(PFlags::CARRY, (Accumulator & PFlags::CARRY));
+			Accumulator = Accumulator >> 1;
+			Accumulator |= carry;
+			data = Accumulator;
+		}
+		else
+		{
+			uint16 adr = ReadMemoryAddress<Mode>();
+			data = ReadMemory8(adr);
+			SetProcessorFlag(PFlags::CARRY, (data & PFlags::CARRY));
+			data = data >> 1;
+			data |= carry;
+			WriteMemory8(adr, data);
+		}
+
+		SetResultFlags(data);
+	}
+
+	template <AdrMode Mode>
+	void CPU::SBC()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+
+		uint16 sum = Accumulator;
+		sum -= memory;
+		sum -= (1 - (ProcessorStatus & PFlags::CARRY));
+
+		bool overflow = false;
+
+		if ((Accumulator ^ sum) & (memory ^ sum) & PFlags::NEGATIVE)
+		{
+			SetProcessorFlag(PFlags::OVER_FLOW, true);
+			SetProcessorFlag(PFlags::CARRY, false);
+		}
+		else
+		{
+			SetProcessorFlag(PFlags::OVER_FLOW, false);
+		}
+
+		// Zero is taken from the full 16 bit result
+		m_zeroResult = (uint8)sum | (uint8)(sum >> 8);
+		m_negativeResult = (uint8)sum;
+		Accumulator = sum;
+	}
+
+	template <AdrMode Mode>
+	void CPU::STA()
+	{
+		WriteMemory8(ReadMemoryAddress<Mode>(), Accumulator);
+	}
+
+	template <AdrMode Mode>
+	void CPU::STX()
+	{
+		WriteMemory8(ReadMemoryAddress<Mode>(), XReg);
+	}
+
+	template <AdrMode Mode>
+	void CPU::STY()
+	{
+		WriteMemory8(ReadMemoryAddress<Mode>(), YReg);
+	}
+
+	template <AdrMode Mode>
+	void CPU::BCS_$B0()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if (ProcessorStatus & PFlags::CARRY)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BEQ_$F0()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if (m_zeroResult == 0)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BMI_$30()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if (m_negativeResult & PFlags::NEGATIVE)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BNE_D0()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if (m_zeroResult != 0)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BPL_$10()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if ((m_negativeResult & PFlags::NEGATIVE) == 0)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BVC_$50()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if ((ProcessorStatus & PFlags::OVER_FLOW) == 0)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BVS_$70()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if (ProcessorStatus & PFlags::OVER_FLOW)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::BCC_$90()
+	{
+		uint16 memory = ReadMemoryAddress<Mode>();
+
+		if ((ProcessorStatus & PFlags::CARRY) == 0)
+		{
+			PC = memory;
+		}
+	}
+
+	template <AdrMode Mode>
+	void CPU::LDA()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		Accumulator = memory;
+		SetResultFlags(Accumulator);
+	}
+
+	template <AdrMode Mode>
+	void CPU::LDX()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		XReg = memory;
+		SetResultFlags(XReg);
+	}
+
+	template <AdrMode Mode>
+	void CPU::LDY()
+	{
+		uint8 memory = ReadMemory8(ReadMemoryAddress<Mode>());
+		YReg = memory;
+		SetResultFlags(YReg);
+	}
+
+	template <AdrMode Mode>
+	void CPU::LSR()
+	{
+		uint8 data = 0;
+
+		if constexpr (Mode == AdrMode::ACCUMULATOR)
+		{
+			PC++;
+			SetProcessorFlag(PFlags::CARRY, (Accumulator & PFlags::CARRY));
+			Accumulator = Accumulator >> 1;
+			data = Accumulator;
+		}
+		else
+		{
+			uint16 adr = ReadMemoryAddress<Mode>();
+			data = ReadMemory8(adr);
+			SetProcessorFlag(PFlags::CARRY, (data & PFlags::CARRY));
+			data = data >> 1;
+			WriteMemory8(adr, data);
+		}
+
+		SetResultFlags(data);
+	}
+
+#pragma endregion instructions/ operation codes used by the 6502 
+
+	// Helper Functions 
+	void CPU::IncrementSP() {
+		(this->SP == 0xFF) ? this->SP = 0 : this->SP++;
+	}
+
+	void CPU::DecrementSP() {
+		(this->SP == 0) ? this->SP = 0xFF : this->SP--;
+	}
+
+	template <AdrMode Mode>
+	uint16 CPU::ReadMemoryAddress()
+	{
+		// Resolved at compile time, each (operation, mode) pair gets its own handler
+		if constexpr (Mode == AdrMode::ZERO_PAGE) return GetMemZeroPage();
+		else if constexpr (Mode == AdrMode::ZERO_PAGEX) return GetMemZeroPageX();
+		else if constexpr (Mode == AdrMode::ZERO_PAGEY) return GetMemZeroPageY();
+		else if constexpr (Mode == AdrMode::ABSOLUTE) return GetMemAbsolute();
+		else if constexpr (Mode == AdrMode::ABSOLUTEX) return GetMemAbsoluteX();
+		else if constexpr (Mode == AdrMode::ABSOLUTEY) return GetMemAbsoluteY();
+		else if constexpr (Mode == AdrMode::ABSOLUTE_INDIRECT) return GetMemAbsoluteIndirect();
+		else if constexpr (Mode == AdrMode::IMMEDIATE) return GetMemImmediate();
+		else if constexpr (Mode == AdrMode::RELATIVE) return GetMemRelative();
+		else if constexpr (Mode == AdrMode::INDEXED_INDIRECT) return GetMemIndexedIndirect();
+		else
+		{
+			static_assert(Mode == AdrMode::INDIRECT_INDEXED, "Operation Addressing Mode Error");
+			return GetMemIndirectIndexed();
+		}
+	}
+
+	uint16 CPU::GetMemZeroPage()
+	{
+		PC++;
+		uint8 M = ReadMemory8(PC);
+		PC++;
+		return M;
+	}
+
+	uint16 CPU::GetMemZeroPageX()
+	{
+		PC++;
+		uint8 M = (uint8)(ReadMemory8(PC) + XReg);
+		PC++;
+		return M;
+	}
+
+	uint16 CPU::GetMemZeroPageY()
+	{
+		PC++;
+		uint8 M = (uint8)(ReadMemory8(PC) + YReg);
+		PC++;
+		return M;
+	}
+
+	uint16 CPU::GetMemAbsolute()
+	{
+		PC++;
+		uint16 Adr = ReadMemory16(PC);
+		PC += 2;
+		return Adr;
+	}
+
+	uint16 CPU::GetMemAbsoluteX()
+	{
+		PC++;
+		uint16 Adr = ReadMemory16(PC);
+		uint16 M = Adr + XReg;
+		PC += 2;
+		return M;
+	}
+
+	uint16 CPU::GetMemAbsoluteY()
+	{
+		PC++;
+		uint16 Adr = ReadMemory16(PC);
+		uint16 M = Adr + YReg;
+		PC += 2;
+		return M;
+	}
+
+	uint16 CPU::GetMemAbsoluteIndirect()
+	{
+		PC++;
+		uint16 Adr;
+
+		// http://www.obelisk.me.uk/6502/reference.html#JMP
+		// An original 6502 has does not correctly fetch the target address if the indirect vector falls on a page boundary (e.g. $xxFF where xx is any value from $00 to $FF). In this case fetches the LSB from $xxFF as expected but takes the MSB from $xx00. This is fixed in some later chips like the 65SC02 so for compatibility always ensure the indirect vector is not at the end of the page.
+		uint8 lsb = ReadMemory8(PC);
+
+		if (lsb == 0xFF)
+		{
+			uint16 msb = ReadMemory8(PC + 1);
+
+			Adr = ReadMemory8(ReadMemory16(PC));
+			Adr |= (((uint16)ReadMemory8(msb << 8)) << 8);
+		}
+		else
+		{
+			Adr = ReadMemory16(ReadMemory16(PC));
+		}
+
+		PC += 2;
+		return Adr;
+	}
+
+	uint16 CPU::GetMemImmediate()
+	{
+		PC++;
+		uint16 M = PC;
+		PC++;
+		return M;
+	}
+
+	uint16 CPU::GetMemRelative()
+	{
+		PC += 2;
+		uint8 M = ReadMemory8(PC - 1);
+
+		if (M & 0x80)
+		{
+			M &= ~0x80;
+			return PC - (128 - M);
+		}
+		else
+		{
+			return PC + M;
+		}
+	}
+
+	uint16 CPU::GetMemIndexedIndirect()
+	{
+		PC++;
+		uint16 Adr = ReadMemory16(ReadMemory8(PC) + XReg);
+		PC++;
+		return Adr;
+	}
+
+	uint16 CPU::GetMemIndirectIndexed()
+	{
+		PC++;
+		uint16 Adr = ReadMemory16(ReadMemory8(PC));
+		uint16 M = Adr + YReg;
+		PC++;
+		return M;
+	}
+}
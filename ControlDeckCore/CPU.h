@@ -0,0 +1,664 @@
+/*
+	Author: Allan Moore
+*/
+
+/*
+	Credit to the talented guys and years of research/ documentation
+	available at http://nesdev.com/
+*/
+
+/*********************************************************************
+	* Class: CPU
+	* --------------------------------------------------------------
+	* Simulates the operation of the 2A03/ 2A07 8 bit microprocessor
+	* developed by Ricoh for use in the nintendo entertainment
+	* system(Famicom) developed by Nintendo, between 1982 and 1994.
+	* --------------------------------------------------------------
+	*
+	* CPU Specification/ Info
+	* --------------------------------------------------------------
+	* From the 6502 processor family
+	*
+	* Unlike the 6502 features a audio processing unit
+	*		pAPU - pseudo Audio Processing Unit
+	*
+	* Lacks support for BCD found on the 6502.
+	*
+	* Uses a 16 bit address bus, valid addresses between ranges:
+	* $0000 - $FFFF
+	*
+	* 64kb of available memory
+**********************************************************************/
+
+/* CPU Memory Map
+
+$10000
+	PRG-ROM
+		* Allocated for cartridge PRG-ROM from $8000
+		* Games with only a single 16kb bank will load into both 8000 & C000 effectively mirrored
+		* Games with 2 16 kb bank will load one into $8000 and one into $C000
+	- PRG-ROM Upper Bank $C000 - $10000
+	- PRG-ROM Lower Bank $8000 - $C000
+$8000
+	SRAM
+
+$6000
+	Expansion ROM
+
+$4020
+	Memory Mapped I/O Registers (Same address bus to address memory and I/O) Not sure of benefits of Memory Mapped I/O over Port Mapped I/O)
+	 - I/O Registers $4000 - $4020
+	 - Mirrors $2008-$3FFF
+		* Mirrors $2000 - $2007 for every 8 bytes
+	 - I/O $2000-$2007
+
+$2000
+	RAM
+	 - Mirrors $000-$07FF
+		* Memory at $000-$07FF mirrored at $0800, $1000, $1800
+		* i.e. RAM, Stack, Zero Page below mirrored here
+	 - RAM $0200 - $07FF
+	 - Stack $0100 - $01FF
+	 - Zero Page $0000 - $00FF
+		* Zero page addresses/ for faster read/write
+		* Special space designated at Zero address space
+		* Naturally 256 bytes 0 - FF
+$0000
+
+*/
+
+#ifndef CPU_6502_H 
+#define CPU_6502_H
+
+#include "AddressingMode.h"
+#include "Common.h"
+#include "ProcessorStatusFlags.h"
+#include "Cartridge.h"
+#include "PPU.h"
+#include "Instruction.h"
+#include "ExecutableMemory.h"
+
+namespace ControlDeck
+{
+	class X64Emitter;
+
+	enum class Controller : uint8
+	{
+		A = 0x1,
+		B = 0x2,
+		SELECT = 0x4,
+		START = 0x8,
+		UP = 0x10,
+		DOWN = 0x20,
+		LEFT = 0x40,
+		RIGHT = 0x80
+	};
+
+	class APU;
+
+	/*	CPUState - everything the CPU needs to carry on from where it left off, a plain struct so it can be copied in one go
+	*	Decoded blocks, native code, page tables & the idle loop cache are derived from the cartridge & stay in CPU.
+	*/
+	struct CPUState
+	{
+		//!< PC - Program Counter - Holds the address of the next instruction, split into first 8 bits PCL, last 8 bits PCH
+		uint16 PC = 0xC000;
+
+		//!< StackPointer - 8 Bit register - serves as offset from $0100 - No overflow - wraps $00 - $FF 
+		//!<			  - Data pushed onto the stack will be placed at $0100 + SP 
+		uint8 SP = 0xFD;
+
+		//!< Accumerlator - 8 bit register for storing the results of arithmetric & logic operations 
+		uint8 Accumulator = 0;
+
+		//!< Index register X - 8 bit register - counter or offset for perticular addressing modes
+		//!< Can be set to value recieved from memory, can be used to get or set value of stack pointer
+		uint8 XReg = 0;
+
+		//!< Index register Y - same as Index register X with the retriction of not being able to set the stack pointer
+		uint8 YReg = 0;
+
+		//!< Processor Status - Contains a number of bit flags in regards to the processors status (See PFLAGS)
+		//!< Bit 5 should always be set to 1 
+		//!< The ZERO & NEGATIVE bits are stale, use GetProcessorStatus() when the full status is observed
+		uint8 ProcessorStatus = 0;
+
+		//!< Lazy N/ Z flags - ZERO is set when m_zeroResult is 0, NEGATIVE is bit 7 of m_negativeResult
+		//!< Kept apart as BIT (and ADC/ SBC on a 16 bit sum) derive N & Z from different values
+		uint8 m_zeroResult = 1;
+		uint8 m_negativeResult = 0;
+
+		//!< Explicit padding, see the static_assert below
+		uint8 m_reserved[3] = {};
+
+		uint32 m_cycleCounter = 0;
+		bool m_startup = true;
+
+		// Interrupt
+		bool m_nmi = false;
+
+		// Vram, oam address & toggle 
+		uint16 m_vramAddress = 0;
+		uint16 m_oamAddress = 0;
+		bool m_vramToggle = false;
+		bool m_scrollFirstWrite = true;
+
+		bool m_controllerLatched = false;
+		uint8 m_controllerReadBit = 0;
+		uint8 m_controller1Input = 0;
+		uint8 m_controller2Input = 0;
+
+		//!< PPU registers $2000 - $2007 as seen by the CPU, addressed with PPU_REGISTER_MASK
+		std::array<uint8, 0x8> m_ppuRegisters = {};
+
+		//!< APU & I/O registers $4000 - $401F
+		std::array<uint8, 0x20> m_ioRegisters = {};
+
+		//!< Work RAM - 2KB internal RAM, zero page, stack & ram $0000 - $07FF stored once, mirrors are mapped by the page table
+		std::array<uint8, 0x800> m_workRAM = {};
+
+		//!< SRAM $6000 - $7FFF, PRG-ROM is read straight from the loaded cartridge
+		std::array<uint8, 0x2000> m_sram = {};
+	};
+
+	//!< No padding bytes, equal states have to serialise to equal bytes for save state comparison & deltas
+	static_assert(std::has_unique_object_representations<CPUState>::value, "CPUState has padding");
+
+	class CPU : private CPUState
+	{
+		friend class PPU;
+	public:
+		CPU();
+		void Init();
+		void CheckForInterrupt();
+		void DebugOutput();
+		void Update();
+
+		//!< Runs instructions until at least cycles have elapsed, returns the cycles elapsed
+		//!< masterClock is the master clock time the run starts at, PPU register accesses catch the PPU up to the CPU first
+		uint32 Run(uint32 cycles, uint64 masterClock);
+
+		//!< CPU is clocked once every 12 NTSC master clock cycles
+		static const uint MASTER_CLOCK_DIVIDER = 12;
+		void SetControllerInput(uint8 input, bool down);
+
+		void LoadCartridge(Cartridge* cartridge);
+		void SetPPU(PPU* ppu) { m_ppu = ppu; }
+		void SetAPU(APU* apu) { m_apu = apu; }
+
+		//!< Opt-in execution mode, runs pre-decoded basic blocks from PRG-ROM instead of single instructions
+		void SetBlockCacheEnabled(bool enabled);
+		bool IsBlockCacheEnabled() const { return m_blockCacheEnabled; }
+
+		//!< Block cache runs the hot pairs in CONTROLDECK_FUSED_PAIRS as single handlers, on by default
+		void SetFusionEnabled(bool enabled);
+
+		//!< Prints how often each fused pair ran since blocks were last invalidated, as a share of all block cache instructions
+		void PrintFusionReport() const;
+
+		//!< Opt-in x86-64 recompiler for hot PRG-ROM blocks, returns false & stays on the interpreter when the host can't support it
+		bool SetJITEnabled(bool enabled);
+		bool IsJITEnabled() const { return m_jitEnabled; }
+
+		//!< Differential test mode - each native block is re-run on the interpreter from the same state, a mismatch throws
+		void SetJITVerifyEnabled(bool enabled) { m_jitVerify = enabled; }
+
+		//!< Spin loops in PRG-ROM that only poll memory are fast-forwarded to the next PPU event, see CPUIdleLoop.cpp
+		void SetIdleSkipEnabled(bool enabled);
+		bool IsIdleSkipEnabled() const { return m_idleSkipEnabled; }
+
+		//!< True when the last Update() fast-forwarded a spin loop, the PPU should then be run up to the CPU before anything else
+		//!< Inside Run() loops are fast-forwarded to the end of the run instead
+		bool HasSkippedIdleLoop() const { return m_idleSkipped; }
+
+		//!< Total cycles credited by idle loop skipping
+		uint64 GetIdleSkippedCycles() const { return m_idleSkippedCycles; }
+
+		// Read/ Write bytes to memory - plain memory pages are a single indexed load/ store, MMIO pages go through their handler
+		uint8 ReadMemory8(uint16 Addr)
+		{
+			const uint8* page = m_readPages[Addr >> 8];
+			return page ? page[Addr & 0xFF] : (this->*m_readHandlers[Addr >> 8])(Addr);
+		}
+
+		void WriteMemory8(uint16 Addr, uint8 Data)
+		{
+			uint8* page = m_writePages[Addr >> 8];
+
+			if (page)
+			{
+				page[Addr & 0xFF] = Data;
+				return;
+			}
+
+			(this->*m_writeHandlers[Addr >> 8])(Addr, Data);
+		}
+
+		uint16 ReadMemory16(uint16 Addr);
+
+		//!< Processor status with the lazily evaluated N/ Z flags folded in
+		uint8 GetProcessorStatus() const
+		{
+			return (ProcessorStatus & ~(PFlags::ZERO | PFlags::NEGATIVE)) | (m_zeroResult == 0 ? PFlags::ZERO : 0) | (m_negativeResult & PFlags::NEGATIVE);
+		}
+
+		uint GetCPUCycles() const { return m_cycleCounter; }
+
+		//!< Instructions executed since power on by any of the interpreter, block cache or JIT, skipped idle loop iterations aren't counted
+		uint64 GetInstructionCount() const { return m_instructionCount; }
+
+		//!< 2KB internal RAM, for hashing & debugging tools
+		const std::array<uint8, 0x800>& GetWorkRAM() const { return m_workRAM; }
+
+		//!< Registers, RAM & bus latches - page tables point into the state, so restoring it in place keeps them valid
+		const CPUState& GetState() const { return *this; }
+		void SetState(const CPUState& state) { static_cast<CPUState&>(*this) = state; }
+		void ResetCPUCycles() { m_cycleCounter = 0; m_startup = false; }
+		void setNMI(bool value) { m_nmi = value; }
+
+	private:
+		typedef uint8(CPU::* ReadHandler)(uint16);
+		typedef void(CPU::* WriteHandler)(uint16, uint8);
+		typedef void(CPU::* OpHandler)();
+
+		//!< A pre-decoded instruction, blocks are runs of these terminated by a null handler
+		//!< Operands are still fetched through PC by the handlers, ROM contents can't change under a block
+		struct MicroOp
+		{
+			OpHandler Handler = nullptr;
+			uint8 Cycles = 0;
+			uint8 Fused = 0;		//!< FUSED_TABLE index + 1, 0 for a single instruction
+			uint16 Instructions = 0;	//!< Terminator only - instructions in the block, fused pairs count twice
+			uint32 Runs = 0;		//!< Times the block was left just before this op, the terminator's are full runs. Fusion report only
+		};
+
+		//!< Pair of opcodes run by a single handler, built from CONTROLDECK_FUSED_PAIRS
+		struct FusedInstruction
+		{
+			uint8 First = 0;
+			uint8 Second = 0;
+			OpHandler Handler = nullptr;
+		};
+
+		static const std::array<FusedInstruction, FUSED_PAIR_COUNT> FUSED_TABLE;
+
+		//!< Both handlers are compile time constants so they inline into one body
+		//!< The first instruction's cycles are counted in between so the second sees the count the interpreter would
+		template <OpHandler First, uint8 FirstCycles, OpHandler Second> void FusedPair()
+		{
+			(this->*First)();
+			m_cycleCounter += FirstCycles;
+			(this->*Second)();
+		}
+
+		//!< Fully specialised handler per opcode, null for unimplemented opcodes
+		static const std::array<OpHandler, 0x100> HANDLER_TABLE;
+
+		//!< Plain function wrappers around HANDLER_TABLE, callable from generated code
+		typedef void(*JitThunk)(CPU*);
+		static const std::array<JitThunk, 0x100> JIT_THUNK_TABLE;
+
+		//!< A natively compiled block, Code runs InstructionCount instructions starting at StartPC
+		struct JitBlock
+		{
+			JitThunk Code = nullptr;
+			uint16 StartPC = 0;
+			uint8 InstructionCount = 0;
+			uint16 LeadCycles = 0;		//!< Cycles before the last instruction, the block only runs when the slice has more left
+		};
+
+		//!< Register, flag & RAM state compared by the JIT differential test mode
+		struct JitState
+		{
+			uint16 PC;
+			uint8 SP, Accumulator, XReg, YReg;
+			uint8 Status;										//!< Observable status, compared
+			uint8 RawStatus, ZeroResult, NegativeResult;		//!< Lazy flag storage, restored only
+			uint32 Cycles;
+			std::array<uint8, 0x800> WorkRAM;
+			std::array<uint8, 0x2000> SRAM;
+
+			bool operator==(const JitState& other) const;
+			void Print(const char* label) const;
+		};
+
+		PPU* m_ppu = nullptr;
+		APU* m_apu = nullptr;
+
+		/*	Memory bus page table - 256 pages of 256 bytes each.
+		*	A page either points directly at host memory (RAM/ PRG-ROM) or is null,
+		*	in which case the page handler deals with the memory mapped I/O.
+		*/
+		std::array<const uint8*, 0x100> m_readPages = {};
+		std::array<uint8*, 0x100> m_writePages = {};
+		std::array<ReadHandler, 0x100> m_readHandlers = {};
+		std::array<WriteHandler, 0x100> m_writeHandlers = {};
+
+		/** Useful Constants - STACK(0x0100), PRGROM_UPPER(0xC000),PRGROM_LOWER(0x8000) **/
+		//!< The locations from which the stack, PRG ROM UPPER/ LOWER BANKS begin
+		const uint16 STACK = 0x0100;
+		const uint16 PRGROM_UPPER = 0xC000;
+		const uint16 PRGROM_LOWER = 0x8000;
+
+		//!< Internal RAM $0000-$07FF is mirrored up to $1FFF, PPU registers $2000-$2007 are mirrored up to $3FFF
+		static const uint16 WORK_RAM_MASK = 0x07FF;
+		static const uint16 PPU_REGISTER_MASK = 0x0007;
+
+		// CPU ADDRESS LOCATIONS
+		// https://wiki.nesdev.com/w/index.php/PPU_registers#OAMADDR
+		static const uint16 PPU_CTRL_ADR = 0x2000;
+		static const uint16 PPU_MASK_ADR = 0x2001;
+		static const uint16 PPU_STATUS_ADR = 0x2002;
+		static const uint16 OAM_ADR = 0x2003;
+		static const uint16 OAM_DATA_ADR = 0x2004;
+		static const uint16 PPU_SCROLL_ADR = 0x2005;
+		static const uint16 PPU_COARSE_SCROLL_ADR = 0x2006;
+		static const uint16 PPU_DATA_ADR = 0x2007;
+		static const uint16 OAM_DMA_ADR = 0x4014;
+		static const uint16 CONTROLLER1_ADR = 0x4016;
+		static const uint16 CONTROLLER2_ADR = 0x4017;
+
+		//!< Runs the next instruction or block via the JIT, block cache or interpreter
+		void Step();
+
+		//!< Executes a single decoded opcode via the opcode table, PC must point at the opcode
+		void Execute(uint8 opCode);
+
+		//!< Builds the memory bus page table
+		void MapMemory();
+
+		/*	Basic block cache - see CPUBlockCache.cpp
+		*	Only PRG-ROM code is cached, blocks end after any branch/ jump/ return
+		*	m_blockLookup holds (index into m_blockOps + 1) per PRG-ROM address, 0 when not yet decoded.
+		*/
+		void ExecuteBlock();
+		//!< Leaves a block before op (run slice end or NMI enabled mid block), counting the instructions run so far
+		void ExitBlock(const MicroOp* first, MicroOp* op);
+		uint32 CompileBlock(uint16 pc);
+		void InvalidateBlocks();
+		bool IsBlockStart(uint16 pc) const;
+
+		//!< Branches, jumps, returns & interrupts end a block
+		static bool EndsBlock(uint8 opCode);
+
+		bool m_blockCacheEnabled = false;
+		bool m_fusionEnabled = true;
+		std::vector<MicroOp> m_blockOps;
+		std::vector<uint32> m_blockLookup;
+
+		//!< A block was left part way at a slice end, the interpreter runs the rest of it so new blocks only start where blocks end
+		bool m_finishingBlock = false;
+
+		/*	x86-64 recompiler - see CPUJit.cpp
+		*	m_jitLookup holds (index into m_jitBlocks + 1) per PRG-ROM address, 0 when not compiled, JIT_NO_BLOCK when not compilable.
+		*	m_jitHeat counts interpreted visits to an address until it is hot enough to compile.
+		*/
+		bool ExecuteJIT();
+		bool IsJITBlockStart(uint16 pc) const;
+		uint32 CompileJITBlock(uint16 pc);
+		bool EmitJITInstruction(X64Emitter& emitter, uint8 opCode, uint16 operand);
+		bool IsJITMMIOAccess(uint8 opCode, uint16 operand) const;
+		int32 GetJITMemoryOffset(uint16 address) const;
+		void InvalidateJIT();
+		void VerifyJITBlock(const JitBlock& block);
+		void CaptureJITState(JitState& state) const;
+		void RestoreJITState(const JitState& state);
+
+		bool m_jitEnabled = false;
+		bool m_jitVerify = false;
+		ExecutableMemory m_jitMemory;
+		size_t m_jitMemoryUsed = 0;
+		std::vector<JitBlock> m_jitBlocks;
+		std::vector<uint32> m_jitLookup;
+		std::vector<uint8> m_jitHeat;
+
+		/*	Idle loop skipping - see CPUIdleLoop.cpp
+		*	m_idleLoops caches per PRG-ROM address whether a spin loop starts there, IDLE_LOOP_UNKNOWN/ IDLE_LOOP_NONE or the cycles per iteration.
+		*/
+		void StepIdleSkip();
+		void SkipIdleLoop();
+		uint8 AnalyseIdleLoop(uint16 head);
+		void InvalidateIdleLoops();
+
+		//!< Run() state
+		uint32 m_runTarget = 0;
+		uint32 m_runStartCycle = 0;
+		uint64 m_runMasterClock = 0;
+		bool m_running = false;
+
+		//!< Catches the PPU up to the current instruction before one of its registers or OAM is touched, only inside Run()
+		void SyncPPU();
+
+		bool m_idleSkipEnabled = false;
+		bool m_idleSkipped = false;
+		uint64 m_idleSkippedCycles = 0;
+		std::vector<uint8> m_idleLoops;
+
+		// Page handlers, $2000-$3FFF PPU registers, $4000-$40FF APU & I/O registers, unmapped/ ROM space
+		uint8 ReadPPURegister(uint16 Addr);
+		void WritePPURegister(uint16 Addr, uint8 Data);
+		uint8 ReadIORegister(uint16 Addr);
+		void WriteIORegister(uint16 Addr, uint8 Data);
+		uint8 ReadOpenBus(uint16 Addr);
+		void WriteROM(uint16 Addr, uint8 Data);
+
+		void SetProcessorFlag(PFlags Flag, bool bEnabled);
+		void SetProcessorStatus(uint8 status);
+
+		//!< Records the result N/ Z are derived from, see m_zeroResult/ m_negativeResult
+		void SetResultFlags(uint8 result) { m_zeroResult = result; m_negativeResult = result; }
+		void PushStack8(uint8 memory);
+		void PushStack16(uint16 memory);
+		uint8 PopStack8();
+		uint16 PopStack16();
+		void IncrementSP();
+		void DecrementSP();
+
+		/*	Read Memory Address - For Address Mode - helper
+		*	Increments the Program Counter
+		*	Establishes the address in memory
+		*	Sets the (custom) M - Memory register accordingly
+		*	returns the memory address
+		*/
+		template <AdrMode Mode> uint16 ReadMemoryAddress();
+		uint16 GetMemZeroPage();
+		uint16 GetMemZeroPageX();
+		uint16 GetMemZeroPageY();
+		uint16 GetMemAbsolute();
+		uint16 GetMemAbsoluteX();
+		uint16 GetMemAbsoluteY();
+		uint16 GetMemAbsoluteIndirect();
+		uint16 GetMemImmediate();
+		uint16 GetMemRelative();
+		uint16 GetMemIndexedIndirect();
+		uint16 GetMemIndirectIndexed();
+
+		Cartridge* m_loadedCartridge = nullptr;
+		uint64 m_instructionCount = 0;
+
+	private:
+
+		//!< Insert about 151 instructions here D:
+#pragma region _6502_Instructions 
+
+#pragma region _Implied_Addressing_Mode_Instructions (25 instructions)
+/***Implied Addressing Mode Instructions***/
+	//!< Software Interrupt 
+		template <AdrMode Mode> void BRK_$00();
+
+		//!< Clears Carry Flag C
+		template <AdrMode Mode> void CLC_$18();
+
+		//!< Clear Decimal Flag D :: Note Decimal Mode not supported on 2A03/07 CPU
+		template <AdrMode Mode> void CLD_$D8();
+
+		//!< Clear Intterupt Disable Flag I
+		template <AdrMode Mode> void CLI_$58();
+
+		//!< Clear Overflow Flag V
+		template <AdrMode Mode> void CLV_$B8();
+
+		//!< Decrement X register by one 
+		template <AdrMode Mode> void DEX_$CA();
+
+		//!< Decrement Y register by one 
+		template <AdrMode Mode> void DEY_$88();
+
+		//!< Increment X register by one
+		template <AdrMode Mode> void INX_$E8();
+
+		//!< Increment Y register by one 
+		template <AdrMode Mode> void INY_$C8();
+
+		//!< Does Nothing :D
+		template <AdrMode Mode> void NOP_$EA();
+
+		//!< Push (A) Accumulator onto stack
+		template <AdrMode Mode> void PHA_$48();
+
+		//!< Push Processor Status onto stack 
+		template <AdrMode Mode> void PHP_$08();
+
+		//!< Pull from stack to (A) Accumulator
+		template <AdrMode Mode> void PLA_$68();
+
+		//!< Pull from stack to (P) Processor Status
+		template <AdrMode Mode> void PLP_$28();
+
+		//!< Return from interrupt
+		template <AdrMode Mode> void RTI_$40();
+
+		//!< Return from Subroutine 
+		template <AdrMode Mode> void RTS_$60();
+
+		//!< Set Carry Flag C
+		template <AdrMode Mode> void SEC_$38();
+
+		//!< Set Decimal Flag D
+		template <AdrMode Mode> void SED_$f8();
+
+		//!< Set Intterupt Disabled Flag
+		template <AdrMode Mode> void SEI_$78();
+
+		//!< Transfer Accumulator to X register 
+		template <AdrMode Mode> void TAX_$AA();
+
+		//!< Transfer Accumulator to Y register
+		template <AdrMode Mode> void TAY_$A8();
+
+		//!< Transfer Stack Pointer to X register
+		template <AdrMode Mode> void TSX_$BA();
+
+		//!< Transfer X register to Accumulator 
+		template <AdrMode Mode> void TXA_$8A();
+
+		//!< Transfer X register to Stack Pointer 
+		template <AdrMode Mode> void TXS_$9A();
+
+		//!< Tranfer Y register to Accumulator 
+		template <AdrMode Mode> void TYA_$98();
+#pragma endregion 
+
+		/*Add memory to Accumulator with carry*/
+		template <AdrMode Mode> void ADC();
+
+		/*AND - Bitwsie AND */
+		template <AdrMode Mode> void AND();
+
+		/*Shift Left*/
+		template <AdrMode Mode> void ASL();
+
+		/*BIT - Test b*/
+		template <AdrMode Mode> void BIT();
+
+		/*CMP = Compare Acumulator with Memory*/
+		template <AdrMode Mode> void CMP();
+
+		/*CPX - Comapre X with Memory*/
+		template <AdrMode Mode> void CPX();
+
+		/*CPY - Compare Y with memory*/
+		template <AdrMode Mode> void CPY();
+
+		/*DEC - Decrement Memory by one*/
+		template <AdrMode Mode> void DEC();
+
+		/*EOR (XOR) = Bitwise Exclusive Or, A^M*/
+		template <AdrMode Mode> void EOR();
+
+		/*Increment Memory by one*/
+		template <AdrMode Mode> void INC();
+
+		/*JMP - Goto address*/
+		template <AdrMode Mode> void JMP();
+
+		/*JSR Jump to SubRoutine */
+		template <AdrMode Mode> void JSR_$20(); //!< Absolute 
+
+		/*LDA - Load Memory Into Accumulator*/
+		template <AdrMode Mode> void LDA();
+
+		/*LDX - Load Memory into X Reg*/
+		template <AdrMode Mode> void LDX();
+
+		/*LDY - Load Memory into Y*/
+		template <AdrMode Mode> void LDY();
+
+		/*LSR - Shift right*/
+		template <AdrMode Mode> void LSR();
+
+		/*ORA - Bitwise OR, A | M*/
+		template <AdrMode Mode> void ORA();
+
+		/*ROL - Rotate Left*/
+		template <AdrMode Mode> void ROL();
+
+		/*ROR - Rotate Right*/
+		template <AdrMode Mode> void ROR();
+
+		/*SBC - Subtract Memory from Accumulator */
+		template <AdrMode Mode> void SBC();
+
+		/*STA - Store Accumulator in Memory*/
+		template <AdrMode Mode> void STA();
+
+		/*STX - Store X reg in memory*/
+		template <AdrMode Mode> void STX();
+
+		/*STY - Store Y reg in memory*/
+		template <AdrMode Mode> void STY();
+
+#pragma region relative
+
+		//!<Branch If Carry is clear 
+		template <AdrMode Mode> void BCC_$90();
+
+		//!< Branch if Carry is set 
+		template <AdrMode Mode> void BCS_$B0();
+
+		//!< Branch if ZERO is set 
+		template <AdrMode Mode> void BEQ_$F0();
+
+		//!< Branch if negative is set 
+		template <AdrMode Mode> void BMI_$30();
+
+		//!< Branch if zero is clear 
+		template <AdrMode Mode> void BNE_D0();
+
+		//!< Branch if negative clear 
+		template <AdrMode Mode> void BPL_$10();
+
+		//!< Branch if overflow is clear 
+		template <AdrMode Mode> void BVC_$50();
+
+		//!< Branch if overflow is set 
+		template <AdrMode Mode> void BVS_$70();
+
+#pragma endregion rel
+
+#pragma endregion instructions/ operation codes used by the 6502 
+
+	};
+}
+
+#endif 
@@ -0,0 +1,222 @@
+// Basic block cache for the CPU, PRG-ROM code is decoded once into runs of MicroOps
+
+#include "CPU.h"
+
+namespace ControlDeck
+{
+	//!< Longest run of instructions decoded into a single block
+	static const uint MAX_BLOCK_LENGTH = 64;
+
+	bool CPU::EndsBlock(uint8 opCode)
+	{
+		return INSTRUCTION_TABLE[opCode].Mode == AdrMode::RELATIVE || opCode == 0x00 || opCode == 0x20
+			|| opCode == 0x40 || opCode == 0x4C || opCode == 0x60 || opCode == 0x6C;
+	}
+
+	void CPU::SetBlockCacheEnabled(bool enabled)
+	{
+		m_blockCacheEnabled = enabled;
+		InvalidateBlocks();
+	}
+
+	void CPU::SetFusionEnabled(bool enabled)
+	{
+		m_fusionEnabled = enabled;
+		InvalidateBlocks();
+	}
+
+	void CPU::InvalidateBlocks()
+	{
+		m_blockOps.clear();
+		m_blockLookup.clear();
+
+		if (m_blockCacheEnabled)
+		{
+			m_blockLookup.resize(0x10000 - PRGROM_LOWER, 0);
+		}
+	}
+
+	bool CPU::IsBlockStart(uint16 pc) const
+	{
+		return m_blockCacheEnabled && m_blockLookup[pc - PRGROM_LOWER] != 0;
+	}
+
+	uint32 CPU::CompileBlock(uint16 pc)
+	{
+		uint32 start = (uint32)m_blockOps.size();
+		uint32 address = pc;
+		uint instructions = 0;
+
+		for (uint i = 0; i < MAX_BLOCK_LENGTH; ++i)
+		{
+			uint8 opCode = ReadMemory8(address);
+			const InstructionInfo& info = INSTRUCTION_TABLE[opCode];
+
+			// Unimplemented opcodes & instructions running off the end of ROM are left to the interpreter
+			if (HANDLER_TABLE[opCode] == nullptr || address + info.Bytes > 0x10000)
+			{
+				break;
+			}
+
+			MicroOp op;
+			op.Handler = HANDLER_TABLE[opCode];
+			op.Cycles = info.Cycles;
+
+			address += info.Bytes;
+
+			// Run the following instruction in the same handler when the pair is listed in FUSED_TABLE
+			if (m_fusionEnabled && !EndsBlock(opCode) && address < 0x10000)
+			{
+				uint8 nextOpCode = ReadMemory8(address);
+				const InstructionInfo& nextInfo = INSTRUCTION_TABLE[nextOpCode];
+
+				for (uint fused = 0; fused < FUSED_PAIR_COUNT; ++fused)
+				{
+					if (FUSED_TABLE[fused].First == opCode && FUSED_TABLE[fused].Second == nextOpCode && address + nextInfo.Bytes <= 0x10000)
+					{
+						op.Handler = FUSED_TABLE[fused].Handler;
+						op.Cycles = nextInfo.Cycles;	// FusedPair adds the first instruction's
+						op.Fused = (uint8)(fused + 1);
+						address += nextInfo.Bytes;
+						opCode = nextOpCode;
+						++i;
+						break;
+					}
+				}
+			}
+
+			m_blockOps.push_back(op);
+			instructions += op.Fused ? 2 : 1;
+
+			if (EndsBlock(opCode))
+			{
+				break;
+			}
+		}
+
+		if (m_blockOps.size() == start)
+		{
+			return 0;
+		}
+
+		// Terminator
+		MicroOp terminator;
+		terminator.Instructions = (uint16)instructions;
+		m_blockOps.push_back(terminator);
+		m_blockLookup[pc - PRGROM_LOWER] = start + 1;
+		return start + 1;
+	}
+
+	void CPU::ExecuteBlock()
+	{
+		uint32 entry = m_blockLookup[PC - PRGROM_LOWER];
+
+		if (entry == 0)
+		{
+			entry = CompileBlock(PC);
+
+			if (entry == 0)
+			{
+				// Nothing decodable here, let the interpreter deal with it
+				Execute(ReadMemory8(PC));
+				return;
+			}
+		}
+
+		// Handlers advance PC themselves so it is valid between ops & after the block
+		MicroOp* first = &m_blockOps[entry - 1];
+		MicroOp* op = first;
+		for (; op->Handler != nullptr; ++op)
+		{
+			// Leave at the end of the run slice like the interpreter does, the slice ends on the next PPU event (NMI)
+			if (m_running && (int32)(m_runTarget - m_cycleCounter) <= (op->Fused ? INSTRUCTION_TABLE[FUSED_TABLE[op->Fused - 1].First].Cycles : 0))
+			{
+				ExitBlock(first, op);
+
+				// A fused pair straddling the slice end, the interpreter runs the first half so the slice stops between the two
+				if (op->Fused && (int32)(m_runTarget - m_cycleCounter) > 0)
+				{
+					Execute(ReadMemory8(PC));
+				}
+				return;
+			}
+
+			(this->*op->Handler)();
+			m_cycleCounter += op->Cycles;
+
+			// A PPUCTRL write can enable NMI while vblank is already flagged, the interpreter takes it before the next
+			// instruction so leave for CheckForInterrupt rather than running out the block
+			if (m_nmi && (m_ppuRegisters[PPU_CTRL_ADR & PPU_REGISTER_MASK] & (uint8)PPUCtrl::VerticalBlanking))
+			{
+				ExitBlock(first, op + 1);
+				return;
+			}
+		}
+
+		op->Runs++;
+		m_instructionCount += op->Instructions;
+	}
+
+	void CPU::ExitBlock(const MicroOp* first, MicroOp* op)
+	{
+		for (; first != op; ++first)
+		{
+			m_instructionCount += first->Fused ? 2 : 1;
+		}
+
+		// Partial run, counted on the op the block was left at so the fusion report can credit the ops before it
+		op->Runs++;
+
+		m_finishingBlock = true;
+	}
+
+	void CPU::PrintFusionReport() const
+	{
+		std::array<uint64, FUSED_PAIR_COUNT> hits = {};
+		uint64 instructions = 0;
+		uint32 blockStart = 0;
+
+		for (uint32 i = 0; i < m_blockOps.size(); ++i)
+		{
+			if (m_blockOps[i].Handler != nullptr)
+			{
+				continue;
+			}
+
+			// Terminator, walk the block backwards - an op ran on every full run & every time the block was left after it
+			uint64 runs = m_blockOps[i].Runs;
+			for (uint32 j = i; j-- > blockStart;)
+			{
+				const MicroOp& op = m_blockOps[j];
+				instructions += runs * (op.Fused ? 2 : 1);
+
+				if (op.Fused)
+				{
+					hits[op.Fused - 1] += runs;
+				}
+
+				runs += op.Runs;
+			}
+
+			blockStart = i + 1;
+		}
+
+		printf("Fusion report - %llu instructions run from the block cache\n", instructions);
+
+		uint64 fusedInstructions = 0;
+		for (uint i = 0; i < FUSED_PAIR_COUNT; ++i)
+		{
+			if (hits[i] == 0)
+			{
+				continue;
+			}
+
+			const FusedInstruction& pair = FUSED_TABLE[i];
+			printf("  %s $%02X + %s $%02X\t%llu\t%.2f%%\n", INSTRUCTION_TABLE[pair.First].Name, pair.First, INSTRUCTION_TABLE[pair.Second].Name, pair.Second,
+				hits[i], instructions ? 200.0 * hits[i] / instructions : 0.0);
+			fusedInstructions += hits[i] * 2;
+		}
+
+		printf("  Fused total\t%llu\t%.2f%%\n", fusedInstructions, instructions ? 100.0 * fusedInstructions / instructions : 0.0);
+	}
+}
@@ -0,0 +1,147 @@
+// Idle loop skipping for the CPU, spin loops polling memory are fast-forwarded to the next PPU event
+
+#include "CPU.h"
+
+namespace ControlDeck
+{
+	//!< m_idleLoops markers, any other value is the cycle count of one loop iteration
+	static const uint8 IDLE_LOOP_UNKNOWN = 0;
+	static const uint8 IDLE_LOOP_NONE = 0xFF;
+
+	//!< Longest loop body considered, excluding the branch back
+	static const uint MAX_IDLE_LOOP_LENGTH = 3;
+
+	//!< Reads without side effects, LDA/ LDX/ LDY/ CMP/ CPX/ CPY/ AND immediate, zero page & absolute and BIT
+	static bool IsPureRead(uint8 opCode)
+	{
+		switch (opCode)
+		{
+		case 0xA9: case 0xA5: case 0xAD:
+		case 0xA2: case 0xA6: case 0xAE:
+		case 0xA0: case 0xA4: case 0xAC:
+		case 0xC9: case 0xC5: case 0xCD:
+		case 0xE0: case 0xE4: case 0xEC:
+		case 0xC0: case 0xC4: case 0xCC:
+		case 0x29: case 0x25: case 0x2D:
+		case 0x24: case 0x2C:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void CPU::SetIdleSkipEnabled(bool enabled)
+	{
+		m_idleSkipEnabled = enabled;
+		m_idleSkipped = false;
+		InvalidateIdleLoops();
+	}
+
+	void CPU::InvalidateIdleLoops()
+	{
+		m_idleLoops.clear();
+
+		if (m_idleSkipEnabled)
+		{
+			m_idleLoops.resize(0x10000 - PRGROM_LOWER, IDLE_LOOP_UNKNOWN);
+		}
+	}
+
+	uint8 CPU::AnalyseIdleLoop(uint16 head)
+	{
+		uint32 address = head;
+		uint cycles = 0;
+
+		for (uint i = 0; i <= MAX_IDLE_LOOP_LENGTH; ++i)
+		{
+			uint8 opCode = ReadMemory8(address);
+			const InstructionInfo& info = INSTRUCTION_TABLE[opCode];
+
+			if (HANDLER_TABLE[opCode] == nullptr || address + info.Bytes > 0x10000)
+			{
+				return IDLE_LOOP_NONE;
+			}
+
+			cycles += info.Cycles;
+
+			// A conditional branch straight back to the head closes the loop, at least one read has to come first
+			if (info.Mode == AdrMode::RELATIVE)
+			{
+				uint16 target = (uint16)(address + 2 + (int8)ReadMemory8(address + 1));
+				return (i > 0 && target == head) ? (uint8)cycles : IDLE_LOOP_NONE;
+			}
+
+			if (!IsPureRead(opCode))
+			{
+				return IDLE_LOOP_NONE;
+			}
+
+			// Absolute reads must hit plain memory or PPUSTATUS, whose only side effect (resetting the write toggle) repeats harmlessly
+			if (info.Mode == AdrMode::ABSOLUTE)
+			{
+				uint16 operand = ReadMemory8(address + 1) | ((uint16)ReadMemory8(address + 2) << 8);
+				bool ppuStatus = operand >= PPU_CTRL_ADR && operand < 0x4000 && (operand & PPU_REGISTER_MASK) == (PPU_STATUS_ADR & PPU_REGISTER_MASK);
+
+				if (m_readPages[operand >> 8] == nullptr && !ppuStatus)
+				{
+					return IDLE_LOOP_NONE;
+				}
+			}
+
+			address += info.Bytes;
+		}
+
+		return IDLE_LOOP_NONE;
+	}
+
+	void CPU::StepIdleSkip()
+	{
+		uint16 startPC = PC;
+		m_idleSkipped = false;
+		Step();
+
+		// Back at or just behind where this step started - a short loop has closed, see if it is only polling
+		if (PC <= startPC && startPC - PC <= 0x10)
+		{
+			SkipIdleLoop();
+		}
+	}
+
+	void CPU::SkipIdleLoop()
+	{
+		// RAM code can change under the cache, a pending NMI has to be taken first
+		if (PC < PRGROM_LOWER || m_nmi || (!m_running && m_ppu == nullptr))
+		{
+			return;
+		}
+
+		// Inside Run() the scheduler has already stopped the run at the next event
+		int32 eventCycles = m_running ? (int32)(m_runTarget - m_cycleCounter) : (int32)(m_ppu->GetCyclesToNextEvent() + 2) / 3;
+
+		if (eventCycles <= 0)
+		{
+			return;
+		}
+
+		uint8& loop = m_idleLoops[PC - PRGROM_LOWER];
+
+		if (loop == IDLE_LOOP_UNKNOWN)
+		{
+			loop = AnalyseIdleLoop(PC);
+		}
+
+		if (loop == IDLE_LOOP_NONE)
+		{
+			return;
+		}
+
+		// The loop only reads memory nothing but the PPU or an interrupt can change, so every iteration until the next PPU event
+		// sees the same values - credit whole iterations up to that event, PC stays at the loop head
+		uint iterations = (eventCycles + loop - 1) / loop;
+		uint cycles = iterations * loop;
+
+		m_cycleCounter += cycles;
+		m_idleSkippedCycles += cycles;
+		m_idleSkipped = true;
+	}
+}
@@ -0,0 +1,609 @@
+// x86-64 recompiler for the CPU, hot PRG-ROM blocks are translated into native code
+// Simple loads/ stores/ transfers/ flag ops on RAM are emitted inline, everything else calls the specialised handler
+
+#include "CPU.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CONTROLDECK_JIT_X64
+#endif
+
+namespace ControlDeck
+{
+	//!< Interpreted visits to an address before a block starting there is compiled
+	static const uint8 JIT_HOT_THRESHOLD = 16;
+
+	//!< Longest run of instructions compiled into a single block
+	static const uint MAX_JIT_BLOCK_LENGTH = 64;
+
+	//!< Generated code buffer, everything is dropped & recompiled when it fills up
+	static const size_t JIT_MEMORY_SIZE = 4 * 1024 * 1024;
+
+	//!< Upper bound on a single native block - worst case instruction is a handler call with the PC & cycle flush, 34 bytes
+	static const size_t MAX_JIT_BLOCK_SIZE = 64 + MAX_JIT_BLOCK_LENGTH * 40;
+
+	//!< m_jitLookup marker for addresses that can't start a native block
+	static const uint32 JIT_NO_BLOCK = 0xFFFFFFFF;
+
+	//!< Minimal x86-64 encoder, every memory operand is [rbx + disp32] with rbx holding the CPU
+	class X64Emitter
+	{
+	public:
+		const std::vector<uint8>& GetCode() const { return m_code; }
+
+		//!< push rbx, move the CPU argument into rbx & keep the stack 16 byte aligned for calls
+		void Prologue()
+		{
+			Emit8(0x53);
+#ifdef _WIN32
+			Emit8(0x48); Emit8(0x89); Emit8(0xCB);					// mov rbx, rcx
+			Emit8(0x48); Emit8(0x83); Emit8(0xEC); Emit8(0x20);		// sub rsp, 32 - shadow space
+#else
+			Emit8(0x48); Emit8(0x89); Emit8(0xFB);					// mov rbx, rdi
+#endif
+		}
+
+		void Epilogue()
+		{
+#ifdef _WIN32
+			Emit8(0x48); Emit8(0x83); Emit8(0xC4); Emit8(0x20);		// add rsp, 32
+#endif
+			Emit8(0x5B);											// pop rbx
+			Emit8(0xC3);											// ret
+		}
+
+		//!< Calls a void(CPU*) function with the CPU as its argument
+		void Call(uint64 function)
+		{
+#ifdef _WIN32
+			Emit8(0x48); Emit8(0x89); Emit8(0xD9);					// mov rcx, rbx
+#else
+			Emit8(0x48); Emit8(0x89); Emit8(0xDF);					// mov rdi, rbx
+#endif
+			Emit8(0x48); Emit8(0xB8); Emit64(function);				// mov rax, imm64
+			Emit8(0xFF); Emit8(0xD0);								// call rax
+		}
+
+		void LoadAL(int32 disp) { Emit8(0x8A); ModRM(0, disp); }
+		void StoreAL(int32 disp) { Emit8(0x88); ModRM(0, disp); }
+		void StoreImm8(int32 disp, uint8 value) { Emit8(0xC6); ModRM(0, disp); Emit8(value); }
+		void StoreImm16(int32 disp, uint16 value) { Emit8(0x66); Emit8(0xC7); ModRM(0, disp); Emit8(value & 0xFF); Emit8(value >> 8); }
+		void Inc8(int32 disp) { Emit8(0xFE); ModRM(0, disp); }
+		void Dec8(int32 disp) { Emit8(0xFE); ModRM(1, disp); }
+		void Or8(int32 disp, uint8 value) { Emit8(0x80); ModRM(1, disp); Emit8(value); }
+		void And8(int32 disp, uint8 value) { Emit8(0x80); ModRM(4, disp); Emit8(value); }
+		void Add32(int32 disp, uint32 value) { Emit8(0x81); ModRM(0, disp); Emit32(value); }
+
+	private:
+		//!< [rbx + disp32] operand, reg is the register or opcode extension
+		void ModRM(uint8 reg, int32 disp)
+		{
+			Emit8(0x80 | (reg << 3) | 0x3);
+			Emit32((uint32)disp);
+		}
+
+		void Emit8(uint8 value) { m_code.push_back(value); }
+		void Emit32(uint32 value) { for (uint i = 0; i < 4; ++i) Emit8((uint8)(value >> (i * 8))); }
+		void Emit64(uint64 value) { for (uint i = 0; i < 8; ++i) Emit8((uint8)(value >> (i * 8))); }
+
+		std::vector<uint8> m_code;
+	};
+
+	//!< Byte offset of a CPU member, generated code addresses everything relative to the CPU
+	static int32 OffsetFrom(const CPU* cpu, const void* member)
+	{
+		return (int32)((const uint8*)member - (const uint8*)cpu);
+	}
+
+	//!< Stores & read-modify-write instructions, these also need a writable page to stay off the MMIO path
+	static bool WritesMemory(uint8 opCode)
+	{
+		switch (opCode)
+		{
+		case 0x81: case 0x84: case 0x85: case 0x86: case 0x8C: case 0x8D: case 0x8E:
+		case 0x91: case 0x94: case 0x95: case 0x96: case 0x99: case 0x9D:
+			return true;
+		default:
+			// ASL/ ROL/ LSR/ ROR/ DEC/ INC on memory - aaabbb10 with an odd bbb, aaa not STX/ LDX
+			return (opCode & 0x03) == 0x02 && (opCode & 0x04) && (opCode >> 5) != 4 && (opCode >> 5) != 5;
+		}
+	}
+
+	bool CPU::SetJITEnabled(bool enabled)
+	{
+#ifdef CONTROLDECK_JIT_X64
+		if (enabled && m_jitMemory.GetData() == nullptr && !m_jitMemory.Allocate(JIT_MEMORY_SIZE))
+		{
+			enabled = false;
+		}
+#else
+		enabled = false;
+#endif
+
+		m_jitEnabled = enabled;
+		InvalidateJIT();
+		return enabled;
+	}
+
+	void CPU::InvalidateJIT()
+	{
+		m_jitBlocks.clear();
+		m_jitLookup.clear();
+		m_jitHeat.clear();
+		m_jitMemoryUsed = 0;
+
+		if (m_jitEnabled)
+		{
+			m_jitLookup.resize(0x10000 - PRGROM_LOWER, 0);
+			m_jitHeat.resize(0x10000 - PRGROM_LOWER, 0);
+		}
+	}
+
+	bool CPU::ExecuteJIT()
+	{
+		uint16 offset = PC - PRGROM_LOWER;
+		uint32 entry = m_jitLookup[offset];
+
+		if (entry == JIT_NO_BLOCK)
+		{
+			return false;
+		}
+
+		if (entry == 0)
+		{
+			// Stay on the interpreter until the address is hot
+			if (++m_jitHeat[offset] < JIT_HOT_THRESHOLD)
+			{
+				return false;
+			}
+
+			entry = CompileJITBlock(PC);
+
+			if (entry == JIT_NO_BLOCK)
+			{
+				return false;
+			}
+		}
+
+		const JitBlock& block = m_jitBlocks[entry - 1];
+
+		// Native blocks can't stop part way, near the end of the run slice the block cache (which can) or the interpreter
+		// takes over so the PPU event isn't overshot
+		if (m_running && (int32)(m_runTarget - m_cycleCounter) <= (int32)block.LeadCycles)
+		{
+			m_finishingBlock = !m_blockCacheEnabled;
+			return false;
+		}
+
+		if (m_jitVerify)
+		{
+			VerifyJITBlock(block);
+		}
+		else
+		{
+			block.Code(this);
+			m_instructionCount += block.InstructionCount;
+		}
+
+		return true;
+	}
+
+	bool CPU::IsJITBlockStart(uint16 pc) const
+	{
+		uint32 entry = m_jitEnabled ? m_jitLookup[pc - PRGROM_LOWER] : 0;
+		return entry != 0 && entry != JIT_NO_BLOCK;
+	}
+
+	bool CPU::IsJITMMIOAccess(uint8 opCode, uint16 operand) const
+	{
+		const AdrMode mode = INSTRUCTION_TABLE[opCode].Mode;
+
+		// (zp,X)/ (zp),Y targets are only known at run time. Loads stay in the block, the handler runs with the cycle count
+		// flushed so a register read syncs the PPU as the interpreter would. Stores may write PPUCTRL or start OAM DMA,
+		// which change the NMI & the cycle count mid block, so they are left to the interpreter
+		if (mode == AdrMode::INDEXED_INDIRECT || mode == AdrMode::INDIRECT_INDEXED)
+		{
+			return WritesMemory(opCode);
+		}
+
+		// JMP/ JSR only use the operand as a target
+		if (opCode == 0x4C || opCode == 0x20 || (mode != AdrMode::ABSOLUTE && mode != AdrMode::ABSOLUTEX && mode != AdrMode::ABSOLUTEY))
+		{
+			return false;
+		}
+
+		// Indexed accesses may carry into the next page
+		uint firstPage = operand >> 8;
+		uint lastPage = mode == AdrMode::ABSOLUTE ? firstPage : (firstPage + 1) & 0xFF;
+
+		for (uint page : { firstPage, lastPage })
+		{
+			if (m_readPages[page] == nullptr || (WritesMemory(opCode) && m_writePages[page] == nullptr))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	int32 CPU::GetJITMemoryOffset(uint16 address) const
+	{
+		// Only RAM & SRAM have writable pages, both live inside the CPU
+		uint8* page = m_writePages[address >> 8];
+		return page ? OffsetFrom(this, page + (address & 0xFF)) : -1;
+	}
+
+	bool CPU::EmitJITInstruction(X64Emitter& emitter, uint8 opCode, uint16 operand)
+	{
+		const int32 accumulator = OffsetFrom(this, &Accumulator);
+		const int32 xReg = OffsetFrom(this, &XReg);
+		const int32 yReg = OffsetFrom(this, &YReg);
+		const int32 sp = OffsetFrom(this, &SP);
+		const int32 status = OffsetFrom(this, &ProcessorStatus);
+		const int32 zero = OffsetFrom(this, &m_zeroResult);
+		const int32 negative = OffsetFrom(this, &m_negativeResult);
+
+		// Low 2 opcode bits pick the register for LDx/ STx - 01 A, 10 X, 00 Y
+		const int32 indexedRegister = (opCode & 0x03) == 0x01 ? accumulator : (opCode & 0x03) == 0x02 ? xReg : yReg;
+
+		switch (opCode)
+		{
+		// LDA/ LDX/ LDY #imm - folded into constant stores
+		case 0xA9: case 0xA2: case 0xA0:
+			emitter.StoreImm8(indexedRegister, (uint8)operand);
+			emitter.StoreImm8(zero, (uint8)operand);
+			emitter.StoreImm8(negative, (uint8)operand);
+			return true;
+
+		// LDA/ LDX/ LDY zero page & absolute
+		case 0xA5: case 0xA6: case 0xA4: case 0xAD: case 0xAE: case 0xAC:
+		{
+			int32 memory = GetJITMemoryOffset(operand);
+
+			if (memory < 0)
+			{
+				// PRG-ROM can't change until a bank switch, which drops every block
+				uint8 value = ReadMemory8(operand);
+				emitter.StoreImm8(indexedRegister, value);
+				emitter.StoreImm8(zero, value);
+				emitter.StoreImm8(negative, value);
+				return true;
+			}
+
+			emitter.LoadAL(memory);
+			emitter.StoreAL(indexedRegister);
+			emitter.StoreAL(zero);
+			emitter.StoreAL(negative);
+			return true;
+		}
+
+		// STA/ STX/ STY zero page & absolute
+		case 0x85: case 0x86: case 0x84: case 0x8D: case 0x8E: case 0x8C:
+		{
+			int32 memory = GetJITMemoryOffset(operand);
+
+			if (memory < 0)
+			{
+				return false;
+			}
+
+			emitter.LoadAL(indexedRegister);
+			emitter.StoreAL(memory);
+			return true;
+		}
+
+		// Transfers
+		case 0xAA: case 0xA8: case 0x8A: case 0x98: case 0xBA: case 0x9A:
+		{
+			int32 source = (opCode == 0xAA || opCode == 0xA8) ? accumulator : (opCode == 0x8A || opCode == 0x9A) ? xReg : opCode == 0x98 ? yReg : sp;
+			int32 destination = (opCode == 0xAA || opCode == 0xBA) ? xReg : opCode == 0xA8 ? yReg : opCode == 0x9A ? sp : accumulator;
+
+			emitter.LoadAL(source);
+			emitter.StoreAL(destination);
+
+			// TXS leaves the flags alone
+			if (opCode != 0x9A)
+			{
+				emitter.StoreAL(zero);
+				emitter.StoreAL(negative);
+			}
+			return true;
+		}
+
+		// INX/ INY/ DEX/ DEY
+		case 0xE8: case 0xC8: case 0xCA: case 0x88:
+		{
+			int32 reg = (opCode == 0xE8 || opCode == 0xCA) ? xReg : yReg;
+
+			if (opCode == 0xE8 || opCode == 0xC8)
+			{
+				emitter.Inc8(reg);
+			}
+			else
+			{
+				emitter.Dec8(reg);
+			}
+
+			emitter.LoadAL(reg);
+			emitter.StoreAL(zero);
+			emitter.StoreAL(negative);
+			return true;
+		}
+
+		// INC/ DEC zero page & absolute
+		case 0xE6: case 0xC6: case 0xEE: case 0xCE:
+		{
+			int32 memory = GetJITMemoryOffset(operand);
+
+			if (memory < 0)
+			{
+				return false;
+			}
+
+			if (opCode == 0xE6 || opCode == 0xEE)
+			{
+				emitter.Inc8(memory);
+			}
+			else
+			{
+				emitter.Dec8(memory);
+			}
+
+			emitter.LoadAL(memory);
+			emitter.StoreAL(zero);
+			emitter.StoreAL(negative);
+			return true;
+		}
+
+		// Flag set/ clear
+		case 0x18: emitter.And8(status, (uint8)~PFlags::CARRY); return true;
+		case 0x38: emitter.Or8(status, PFlags::CARRY); return true;
+		case 0xD8: emitter.And8(status, (uint8)~PFlags::DECIMAL_MODE); return true;
+		case 0xF8: emitter.Or8(status, PFlags::DECIMAL_MODE); return true;
+		case 0x58: emitter.And8(status, (uint8)~PFlags::INTERRUPT_DISABLED); return true;
+		case 0x78: emitter.Or8(status, PFlags::INTERRUPT_DISABLED); return true;
+		case 0xB8: emitter.And8(status, (uint8)~PFlags::OVER_FLOW); return true;
+
+		case 0xEA:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	uint32 CPU::CompileJITBlock(uint16 pc)
+	{
+		uint16 offset = pc - PRGROM_LOWER;
+
+		// Out of code space, start over
+		if (m_jitMemoryUsed + MAX_JIT_BLOCK_SIZE > m_jitMemory.GetSize())
+		{
+			InvalidateJIT();
+		}
+
+		X64Emitter emitter;
+		emitter.Prologue();
+
+		const int32 programCounter = OffsetFrom(this, &PC);
+		uint32 address = pc;
+		const int32 cycleCounter = OffsetFrom(this, &m_cycleCounter);
+		uint32 cycles = 0;
+		uint32 leadCycles = 0;
+		uint32 flushedCycles = 0;
+		uint8 count = 0;
+
+		// Inline instructions don't advance PC, it is written back before the next handler call & at the end of the block
+		bool pcStale = false;
+
+		for (uint i = 0; i < MAX_JIT_BLOCK_LENGTH; ++i)
+		{
+			uint8 opCode = ReadMemory8(address);
+			const InstructionInfo& info = INSTRUCTION_TABLE[opCode];
+
+			// Unimplemented opcodes & instructions running off the end of ROM are left to the interpreter
+			if (JIT_THUNK_TABLE[opCode] == nullptr || address + info.Bytes > 0x10000)
+			{
+				break;
+			}
+
+			uint16 operand = 0;
+
+			if (info.Bytes > 1)
+			{
+				operand = ReadMemory8(address + 1);
+			}
+
+			if (info.Bytes > 2)
+			{
+				operand |= (uint16)ReadMemory8(address + 2) << 8;
+			}
+
+			// MMIO is timing sensitive, end the block so the interpreter runs it with an exact cycle count
+			if (IsJITMMIOAccess(opCode, operand))
+			{
+				break;
+			}
+
+			if (EmitJITInstruction(emitter, opCode, operand))
+			{
+				pcStale = true;
+			}
+			else
+			{
+				if (pcStale)
+				{
+					emitter.StoreImm16(programCounter, (uint16)address);
+				}
+
+				// Handlers see the cycle count the interpreter would, up to the start of their own instruction
+				if (cycles != flushedCycles)
+				{
+					emitter.Add32(cycleCounter, cycles - flushedCycles);
+					flushedCycles = cycles;
+				}
+
+				emitter.Call((uint64)JIT_THUNK_TABLE[opCode]);
+				pcStale = false;
+			}
+
+			leadCycles = cycles;
+			cycles += info.Cycles;
+			count++;
+			address += info.Bytes;
+
+			if (EndsBlock(opCode))
+			{
+				break;
+			}
+		}
+
+		if (count == 0)
+		{
+			m_jitLookup[offset] = JIT_NO_BLOCK;
+			return JIT_NO_BLOCK;
+		}
+
+		if (pcStale)
+		{
+			emitter.StoreImm16(programCounter, (uint16)address);
+		}
+
+		// Handlers don't add cycles of their own, the base cycles not flushed before a handler call are added here
+		if (cycles != flushedCycles)
+		{
+			emitter.Add32(cycleCounter, cycles - flushedCycles);
+		}
+		emitter.Epilogue();
+
+		const std::vector<uint8>& code = emitter.GetCode();
+		uint8* destination = m_jitMemory.GetData() + m_jitMemoryUsed;
+
+		if (!m_jitMemory.SetWritable(true))
+		{
+			m_jitEnabled = false;
+			return JIT_NO_BLOCK;
+		}
+
+		memcpy(destination, code.data(), code.size());
+
+		if (!m_jitMemory.SetWritable(false))
+		{
+			m_jitEnabled = false;
+			return JIT_NO_BLOCK;
+		}
+
+		m_jitMemoryUsed += (code.size() + 15) & ~(size_t)15;
+
+		JitBlock block;
+		block.Code = (JitThunk)destination;
+		block.StartPC = pc;
+		block.InstructionCount = count;
+		block.LeadCycles = (uint16)leadCycles;
+		m_jitBlocks.push_back(block);
+
+		m_jitLookup[offset] = (uint32)m_jitBlocks.size();
+		return m_jitLookup[offset];
+	}
+
+	const std::array<CPU::JitThunk, 0x100> CPU::JIT_THUNK_TABLE = []()
+	{
+		std::array<CPU::JitThunk, 0x100> table = {};
+
+#define CONTROLDECK_OPCODE_THUNK(opCode, name, handler, mode, bytes, cycles, cyclesPage) \
+		table[opCode] = [](CPU* cpu) { (cpu->*HANDLER_TABLE[opCode])(); };
+		CONTROLDECK_OPCODES(CONTROLDECK_OPCODE_THUNK)
+#undef CONTROLDECK_OPCODE_THUNK
+
+		return table;
+	}();
+
+	bool CPU::JitState::operator==(const JitState& other) const
+	{
+		return PC == other.PC && SP == other.SP && Accumulator == other.Accumulator && XReg == other.XReg && YReg == other.YReg
+			&& Status == other.Status && Cycles == other.Cycles && WorkRAM == other.WorkRAM && SRAM == other.SRAM;
+	}
+
+	void CPU::JitState::Print(const char* label) const
+	{
+		printf("%s PC:%04X A:%02X X:%02X Y:%02X P:%02X SP:%02X CYC:%u\n", label, PC, Accumulator, XReg, YReg, Status, SP, Cycles);
+	}
+
+	void CPU::CaptureJITState(JitState& state) const
+	{
+		state.PC = PC;
+		state.SP = SP;
+		state.Accumulator = Accumulator;
+		state.XReg = XReg;
+		state.YReg = YReg;
+		state.Status = GetProcessorStatus();
+		state.RawStatus = ProcessorStatus;
+		state.ZeroResult = m_zeroResult;
+		state.NegativeResult = m_negativeResult;
+		state.Cycles = m_cycleCounter;
+		state.WorkRAM = m_workRAM;
+		state.SRAM = m_sram;
+	}
+
+	void CPU::RestoreJITState(const JitState& state)
+	{
+		PC = state.PC;
+		SP = state.SP;
+		Accumulator = state.Accumulator;
+		XReg = state.XReg;
+		YReg = state.YReg;
+		ProcessorStatus = state.RawStatus;
+		m_zeroResult = state.ZeroResult;
+		m_negativeResult = state.NegativeResult;
+		m_cycleCounter = state.Cycles;
+		m_workRAM = state.WorkRAM;
+		m_sram = state.SRAM;
+	}
+
+	void CPU::VerifyJITBlock(const JitBlock& block)
+	{
+		// Native first, then rewind & step the interpreter over the same instructions - the interpreter's result is kept
+		// Blocks never contain static MMIO accesses, indexed/ indirect ones into MMIO would see their side effects twice
+		JitState before, native, interpreted;
+
+		CaptureJITState(before);
+		block.Code(this);
+		CaptureJITState(native);
+
+		RestoreJITState(before);
+		for (uint i = 0; i < block.InstructionCount; ++i)
+		{
+			Execute(ReadMemory8(PC));
+		}
+		CaptureJITState(interpreted);
+
+		if (!(native == interpreted))
+		{
+			printf("JIT mismatch in block $%04X (%u instructions)\n", block.StartPC, block.InstructionCount);
+			before.Print("before     ");
+			native.Print("native     ");
+			interpreted.Print("interpreter");
+
+			// Registers can agree while a store went astray, show where memory first differs
+			for (uint i = 0; i < native.WorkRAM.size(); ++i)
+			{
+				if (native.WorkRAM[i] != interpreted.WorkRAM[i])
+				{
+					printf("RAM $%04X native:%02X interpreter:%02X\n", i, native.WorkRAM[i], interpreted.WorkRAM[i]);
+					break;
+				}
+			}
+
+			for (uint i = 0; i < native.SRAM.size(); ++i)
+			{
+				if (native.SRAM[i] != interpreted.SRAM[i])
+				{
+					printf("SRAM $%04X native:%02X interpreter:%02X\n", 0x6000 + i, native.SRAM[i], interpreted.SRAM[i]);
+					break;
+				}
+			}
+			throw("JIT block differs from the interpreter");
+		}
+	}
+}
@@ -9,10 +9,11 @@
 #include <vector>
 #include "Types.h"
 
-#include <SDL2/SDL.h>
 #include <string>
 #include <functional>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 
 using String = std::string;
 
@@ -22,6 +23,4 @@ using UniquePtr = std::unique_ptr<T>;
 template <class T>
 using SharedPtr = std::shared_ptr<T>;
 
-constexpr auto PI = 3.1415926535897932385;
-
-#undef main
\ No newline at end of file
+constexpr auto PI = 3.1415926535897932385;
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "Console.h"
+
+namespace ControlDeck
+{
+	static uint64 HashBytes(const uint8* data, size_t size, uint64 hash)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	static SaveStateHeader MakeSaveStateHeader(uint64 romHash)
+	{
+		SaveStateHeader header = {};
+		header.Magic = SAVE_STATE_MAGIC;
+		header.Version = SAVE_STATE_VERSION;
+		header.HeaderSize = sizeof(SaveStateHeader);
+		header.CPUSize = sizeof(CPUState);
+		header.PPUSize = sizeof(PPUState);
+		header.APUSize = sizeof(APUState);
+		header.SchedulerSize = sizeof(SchedulerState);
+		header.RomHash = romHash;
+		return header;
+	}
+
+	Console::Console()
+	{
+		m_cartridge = std::make_unique<Cartridge>();
+		m_cpu = std::make_unique<CPU>();
+		m_ppu = std::make_unique<PPU>(m_cpu.get());
+		m_apu = std::make_unique<APU>(m_cpu.get());
+		m_cpu->SetPPU(m_ppu.get());
+		m_cpu->SetAPU(m_apu.get());
+		m_apu->Init();
+		m_cpu->Init();
+		m_scheduler = std::make_unique<Scheduler>(m_cpu.get(), m_ppu.get(), m_apu.get());
+	}
+
+	bool Console::LoadCartridge(const String& path)
+	{
+		if (!m_cartridge->Load(path))
+		{
+			return false;
+		}
+
+		m_cpu->LoadCartridge(m_cartridge.get());
+
+		m_romHash = 14695981039346656037ULL;
+		for (int bank = 0; bank < m_cartridge->GetNumPRGRomBanks(); ++bank)
+		{
+			const std::vector<uint8>& data = m_cartridge->GetPRGRomBank(bank);
+			m_romHash = HashBytes(data.data(), data.size(), m_romHash);
+		}
+
+		for (int bank = 0; bank < m_cartridge->GetNumVRamBanks(); ++bank)
+		{
+			const std::vector<uint8>& data = m_cartridge->GetCHRBank(bank);
+			m_romHash = HashBytes(data.data(), data.size(), m_romHash);
+		}
+
+		return true;
+	}
+
+	void Console::RunFrame()
+	{
+		m_scheduler->RunFrame();
+		m_cpu->ResetCPUCycles();
+	}
+
+	void Console::CaptureState(ConsoleState& state) const
+	{
+		state.CPU = m_cpu->GetState();
+		state.PPU = m_ppu->GetState();
+		state.APU = m_apu->GetState();
+		state.Scheduler = m_scheduler->GetState();
+	}
+
+	void Console::RestoreState(const ConsoleState& state)
+	{
+		m_cpu->SetState(state.CPU);
+		m_ppu->SetState(state.PPU);
+		m_apu->SetState(state.APU);
+		m_scheduler->SetState(state.Scheduler);
+	}
+
+	void Console::SaveState(std::vector<uint8>& buffer) const
+	{
+		buffer.resize(SAVE_STATE_SIZE);
+
+		const SaveStateHeader header = MakeSaveStateHeader(m_romHash);
+		uint8* out = buffer.data();
+
+		memcpy(out, &header, sizeof(header));
+		out += sizeof(header);
+		memcpy(out, &m_cpu->GetState(), sizeof(CPUState));
+		out += sizeof(CPUState);
+		memcpy(out, &m_ppu->GetState(), sizeof(PPUState));
+		out += sizeof(PPUState);
+		memcpy(out, &m_apu->GetState(), sizeof(APUState));
+		out += sizeof(APUState);
+		memcpy(out, &m_scheduler->GetState(), sizeof(SchedulerState));
+	}
+
+	bool Console::LoadState(const std::vector<uint8>& buffer)
+	{
+		if (buffer.size() < sizeof(SaveStateHeader))
+		{
+			printf("Save state truncated\n");
+			return false;
+		}
+
+		SaveStateHeader header;
+		memcpy(&header, buffer.data(), sizeof(header));
+
+		const SaveStateHeader expected = MakeSaveStateHeader(m_romHash);
+
+		if (header.Magic != expected.Magic || header.Version != expected.Version)
+		{
+			printf("Save state version %u not supported\n", header.Magic == expected.Magic ? header.Version : 0);
+			return false;
+		}
+
+		if (memcmp(&header, &expected, offsetof(SaveStateHeader, RomHash)) != 0 || buffer.size() != SAVE_STATE_SIZE)
+		{
+			printf("Save state layout doesn't match this build\n");
+			return false;
+		}
+
+		if (header.RomHash != expected.RomHash)
+		{
+			printf("Save state is for a different ROM\n");
+			return false;
+		}
+
+		ConsoleState state;
+		const uint8* in = buffer.data() + sizeof(SaveStateHeader);
+
+		memcpy(&state.CPU, in, sizeof(CPUState));
+		in += sizeof(CPUState);
+		memcpy(&state.PPU, in, sizeof(PPUState));
+		in += sizeof(PPUState);
+		memcpy(&state.APU, in, sizeof(APUState));
+		in += sizeof(APUState);
+		memcpy(&state.Scheduler, in, sizeof(SchedulerState));
+
+		RestoreState(state);
+		return true;
+	}
+
+	void Console::SetControllerState(uint8 buttons)
+	{
+		m_cpu->SetControllerInput(0xFF, false);
+		m_cpu->SetControllerInput(buttons, true);
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Common.h"
+#include "Cartridge.h"
+#include "CPU.h"
+#include "PPU.h"
+#include "APU.h"
+#include "Scheduler.h"
+
+namespace ControlDeck
+{
+	//!< All mutable emulation state of a console in one plain struct, the cartridge & derived caches are shared/ rebuilt instead
+	struct ConsoleState
+	{
+		CPUState CPU;
+		PPUState PPU;
+		APUState APU;
+		SchedulerState Scheduler;
+	};
+
+	static_assert(std::is_trivially_copyable<ConsoleState>::value, "ConsoleState must stay a plain copyable struct");
+
+	/*	Save state format - a fixed header followed by the raw ConsoleState bytes, little endian as laid out by the compiler
+	*	Bump SAVE_STATE_VERSION whenever one of the state structs changes, the section sizes catch layouts that were missed.
+	*/
+	struct SaveStateHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint16 HeaderSize;
+		uint32 CPUSize;
+		uint32 PPUSize;
+		uint32 APUSize;
+		uint32 SchedulerSize;
+		uint64 RomHash;			//!< FNV-1a of the PRG & CHR banks, states only load onto the same ROM
+	};
+
+	static const uint32 SAVE_STATE_MAGIC = 0x53534443;	// "CDSS"
+	static const uint16 SAVE_STATE_VERSION = 1;
+	static const size_t SAVE_STATE_SIZE = sizeof(SaveStateHeader) + sizeof(ConsoleState);
+
+	/*	Console - one complete NES, cartridge, CPU, PPU, APU & scheduler wired together
+	*	All emulation state lives in the instance, any number of consoles can run side by side in one process as long as
+	*	each one is only driven from one thread at a time, see ConsolePool.
+	*/
+	class Console
+	{
+	public:
+		Console();
+
+		//!< Loads the ROM at path into the console, returns false when the file can't be read
+		bool LoadCartridge(const String& path);
+
+		//!< Runs until the PPU finishes the current frame
+		void RunFrame();
+
+		//!< Frames run with rendering off keep their timing & status flags but leave the framebuffer stale, see PPU::SetRenderEnabled
+		void SetRenderEnabled(bool enabled) { m_ppu->SetRenderEnabled(enabled); }
+		bool IsRenderEnabled() const { return m_ppu->IsRenderEnabled(); }
+
+		//!< Sets every controller 1 button at once, see Controller for the bits
+		void SetControllerState(uint8 buttons);
+
+		//!< Copies the whole console state out/ back in, only valid between frames - RunFrame() must not be running
+		void CaptureState(ConsoleState& state) const;
+		void RestoreState(const ConsoleState& state);
+
+		//!< Writes a save state into buffer, resized to SAVE_STATE_SIZE - reusing the buffer avoids any allocation
+		//!< NROM has no bank registers, switching mappers would add theirs to ConsoleState
+		void SaveState(std::vector<uint8>& buffer) const;
+
+		//!< Loads a save state written by SaveState(), returns false & leaves the console untouched when the buffer is
+		//!< truncated, from another version/ build layout or for a different ROM
+		bool LoadState(const std::vector<uint8>& buffer);
+
+		CPU* GetCPU() { return m_cpu.get(); }
+		PPU* GetPPU() { return m_ppu.get(); }
+		APU* GetAPU() { return m_apu.get(); }
+		Scheduler* GetScheduler() { return m_scheduler.get(); }
+
+	private:
+		UniquePtr<Cartridge> m_cartridge;
+		UniquePtr<CPU> m_cpu;
+		UniquePtr<PPU> m_ppu;
+		UniquePtr<APU> m_apu;
+		UniquePtr<Scheduler> m_scheduler;
+
+		uint64 m_romHash = 0;
+	};
+}
@@ -0,0 +1,108 @@
+#include "ConsolePool.h"
+#include "Console.h"
+#include <algorithm>
+
+namespace ControlDeck
+{
+	ConsolePool::ConsolePool(uint threads)
+	{
+		if (threads == 0)
+		{
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		for (uint i = 0; i < threads; ++i)
+		{
+			m_workers.emplace_back(&ConsolePool::WorkerLoop, this);
+		}
+	}
+
+	ConsolePool::~ConsolePool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+
+		m_wake.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ConsolePool::RunFrames(const std::vector<Console*>& consoles, uint frames)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_consoles = &consoles;
+		m_frames = frames;
+		m_nextConsole = 0;
+		m_busyWorkers = (uint)m_workers.size();
+		m_error = nullptr;
+		m_batch++;
+
+		m_wake.notify_all();
+		m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+		m_consoles = nullptr;
+
+		if (m_error)
+		{
+			throw(m_error);
+		}
+	}
+
+	void ConsolePool::WorkerLoop()
+	{
+		uint64 batch = 0;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&] { return m_quit || m_batch != batch; });
+
+				if (m_quit)
+				{
+					return;
+				}
+
+				batch = m_batch;
+			}
+
+			// Claim consoles until the batch runs dry, a console is only ever touched by the worker that claimed it
+			const char* error = nullptr;
+
+			for (uint index = m_nextConsole++; index < m_consoles->size(); index = m_nextConsole++)
+			{
+				try
+				{
+					Console* console = (*m_consoles)[index];
+
+					for (uint frame = 0; frame < m_frames; ++frame)
+					{
+						console->RunFrame();
+					}
+				}
+				catch (const char* message)
+				{
+					error = message;
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (error && !m_error)
+				{
+					m_error = error;
+				}
+
+				if (--m_busyWorkers == 0)
+				{
+					m_done.notify_one();
+				}
+			}
+		}
+	}
+}
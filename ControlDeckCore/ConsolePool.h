@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Common.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ControlDeck
+{
+	class Console;
+
+	/*	ConsolePool - worker threads that run many independent consoles at once, for ROM regression farms & batch environments
+	*	Consoles share no state, so each one is handed whole to a single worker per RunFrames() call & nothing is locked while
+	*	they run. Workers stay alive between calls so stepping a batch a frame at a time only costs a wake up.
+	*/
+	class ConsolePool
+	{
+	public:
+		//!< threads 0 uses one worker per hardware thread
+		ConsolePool(uint threads = 0);
+		~ConsolePool();
+
+		//!< Runs frames on every console & blocks until they are all done
+		//!< An exception thrown by a console is rethrown here once the other consoles have finished
+		void RunFrames(const std::vector<Console*>& consoles, uint frames);
+
+		uint GetThreadCount() const { return (uint)m_workers.size(); }
+
+	private:
+		void WorkerLoop();
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+
+		//!< Current batch, consoles are claimed one at a time through m_nextConsole
+		const std::vector<Console*>* m_consoles = nullptr;
+		uint m_frames = 0;
+		std::atomic<uint> m_nextConsole = { 0 };
+		uint m_busyWorkers = 0;
+		uint64 m_batch = 0;
+		bool m_quit = false;
+
+		const char* m_error = nullptr;
+	};
+}
@@ -0,0 +1,92 @@
+#include "ExecutableMemory.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace ControlDeck
+{
+	ExecutableMemory::~ExecutableMemory()
+	{
+		Release();
+	}
+
+	bool ExecutableMemory::Allocate(size_t size)
+	{
+		Release();
+
+#ifdef _WIN32
+		void* memory = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+		if (memory == nullptr)
+		{
+			return false;
+		}
+#else
+		void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (memory == MAP_FAILED)
+		{
+			return false;
+		}
+#endif
+
+		m_data = (uint8*)memory;
+		m_size = size;
+
+		// Make sure the host actually allows flipping the pages to executable
+		if (!SetWritable(false))
+		{
+			Release();
+			return false;
+		}
+
+		return true;
+	}
+
+	void ExecutableMemory::Release()
+	{
+		if (m_data == nullptr)
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+		munmap(m_data, m_size);
+#endif
+
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	bool ExecutableMemory::SetWritable(bool writable)
+	{
+		if (m_data == nullptr)
+		{
+			return false;
+		}
+
+#ifdef _WIN32
+		DWORD oldProtect = 0;
+		if (!VirtualProtect(m_data, m_size, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &oldProtect))
+		{
+			return false;
+		}
+
+		if (!writable)
+		{
+			FlushInstructionCache(GetCurrentProcess(), m_data, m_size);
+		}
+
+		return true;
+#else
+		return mprotect(m_data, m_size, writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC)) == 0;
+#endif
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Common.h"
+
+namespace ControlDeck
+{
+	/*	Page aligned host memory for generated code.
+	*	Memory is either writable or executable, never both - SetWritable(true) before emitting, SetWritable(false) before running.
+	*/
+	class ExecutableMemory
+	{
+	public:
+		ExecutableMemory() = default;
+		~ExecutableMemory();
+
+		ExecutableMemory(const ExecutableMemory&) = delete;
+		ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+		//!< Returns false when the host refuses to hand out executable memory
+		bool Allocate(size_t size);
+		void Release();
+		bool SetWritable(bool writable);
+
+		uint8* GetData() const { return m_data; }
+		size_t GetSize() const { return m_size; }
+
+	private:
+		uint8* m_data = nullptr;
+		size_t m_size = 0;
+	};
+}
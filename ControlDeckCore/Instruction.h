@@ -0,0 +1,237 @@
+#pragma once
+
+#include "Common.h"
+#include "AddressingMode.h"
+#include <array>
+
+namespace ControlDeck
+{
+	/** Static description of a single opcode, the opcode table holds one of these for every byte value. */
+	struct InstructionInfo
+	{
+		const char* Name = "ERR";
+		AdrMode Mode = AdrMode::NONE;
+		uint8 Bytes = 1;
+		uint8 Cycles = 0;
+		uint8 CyclePageBoundary = 0;
+	};
+
+	/*	Every implemented opcode as OPCODE(opCode, name, handler, mode, bytes, cycles, cyclesPageBoundary)
+	*	The same list builds the constexpr INSTRUCTION_TABLE below and the dispatch switch in CPU::Execute
+	*	so metadata and handlers can't drift apart.
+	*/
+#define CONTROLDECK_OPCODES(OPCODE) \
+	OPCODE(0x00, BRK, BRK_$00, IMPLIED, 1, 7, 0) \
+	OPCODE(0x69, ADC, ADC, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0x65, ADC, ADC, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x75, ADC, ADC, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0x6D, ADC, ADC, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x7D, ADC, ADC, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0x79, ADC, ADC, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0x61, ADC, ADC, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0x71, ADC, ADC, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0x29, AND, AND, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0x25, AND, AND, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x35, AND, AND, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0x2D, AND, AND, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x3D, AND, AND, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0x39, AND, AND, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0x21, AND, AND, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0x31, AND, AND, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0x0A, ASL, ASL, ACCUMULATOR, 1, 2, 0) \
+	OPCODE(0x06, ASL, ASL, ZERO_PAGE, 2, 5, 0) \
+	OPCODE(0x16, ASL, ASL, ZERO_PAGEX, 2, 6, 0) \
+	OPCODE(0x0E, ASL, ASL, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0x1E, ASL, ASL, ABSOLUTEX, 3, 7, 0) \
+	OPCODE(0x90, BCC, BCC_$90, RELATIVE, 2, 2, 0) \
+	OPCODE(0xB0, BCS, BCS_$B0, RELATIVE, 2, 2, 0) \
+	OPCODE(0xF0, BEQ, BEQ_$F0, RELATIVE, 2, 2, 0) \
+	OPCODE(0x24, BIT, BIT, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x2C, BIT, BIT, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x30, BMI, BMI_$30, RELATIVE, 2, 2, 0) \
+	OPCODE(0xD0, BNE, BNE_D0, RELATIVE, 2, 2, 0) \
+	OPCODE(0x10, BPL, BPL_$10, RELATIVE, 2, 2, 0) \
+	OPCODE(0x50, BVC, BVC_$50, RELATIVE, 2, 2, 0) \
+	OPCODE(0x70, BVS, BVS_$70, RELATIVE, 2, 2, 0) \
+	OPCODE(0x18, CLC, CLC_$18, IMPLIED, 1, 2, 0) \
+	OPCODE(0xD8, CLD, CLD_$D8, IMPLIED, 1, 2, 0) \
+	OPCODE(0x58, CLI, CLI_$58, IMPLIED, 1, 2, 0) \
+	OPCODE(0xB8, CLV, CLV_$B8, IMPLIED, 1, 2, 0) \
+	OPCODE(0xC9, CMP, CMP, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xC5, CMP, CMP, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xD5, CMP, CMP, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0xCD, CMP, CMP, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xDD, CMP, CMP, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0xD9, CMP, CMP, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0xC1, CMP, CMP, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0xD1, CMP, CMP, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0xE0, CPX, CPX, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xE4, CPX, CPX, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xEC, CPX, CPX, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xC0, CPY, CPY, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xC4, CPY, CPY, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xCC, CPY, CPY, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xC6, DEC, DEC, ZERO_PAGE, 2, 5, 0) \
+	OPCODE(0xD6, DEC, DEC, ZERO_PAGEX, 2, 6, 0) \
+	OPCODE(0xCE, DEC, DEC, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0xDE, DEC, DEC, ABSOLUTEX, 3, 7, 0) \
+	OPCODE(0xCA, DEX, DEX_$CA, IMPLIED, 1, 2, 0) \
+	OPCODE(0x88, DEY, DEY_$88, IMPLIED, 1, 2, 0) \
+	OPCODE(0x49, EOR, EOR, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0x45, EOR, EOR, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x55, EOR, EOR, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0x4D, EOR, EOR, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x5D, EOR, EOR, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0x59, EOR, EOR, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0x41, EOR, EOR, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0x51, EOR, EOR, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0xE6, INC, INC, ZERO_PAGE, 2, 5, 0) \
+	OPCODE(0xF6, INC, INC, ZERO_PAGEX, 2, 6, 0) \
+	OPCODE(0xEE, INC, INC, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0xFE, INC, INC, ABSOLUTEX, 3, 7, 0) \
+	OPCODE(0xE8, INX, INX_$E8, IMPLIED, 1, 2, 0) \
+	OPCODE(0xC8, INY, INY_$C8, IMPLIED, 1, 2, 0) \
+	OPCODE(0x4C, JMP, JMP, ABSOLUTE, 3, 3, 0) \
+	OPCODE(0x6C, JMP, JMP, ABSOLUTE_INDIRECT, 3, 5, 0) \
+	OPCODE(0x20, JSR, JSR_$20, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0xA9, LDA, LDA, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xA5, LDA, LDA, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xB5, LDA, LDA, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0xAD, LDA, LDA, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xBD, LDA, LDA, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0xB9, LDA, LDA, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0xA1, LDA, LDA, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0xB1, LDA, LDA, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0xA2, LDX, LDX, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xA6, LDX, LDX, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xB6, LDX, LDX, ZERO_PAGEY, 2, 4, 0) \
+	OPCODE(0xAE, LDX, LDX, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xBE, LDX, LDX, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0xA0, LDY, LDY, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xA4, LDY, LDY, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xB4, LDY, LDY, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0xAC, LDY, LDY, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xBC, LDY, LDY, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0x4A, LSR, LSR, ACCUMULATOR, 1, 2, 0) \
+	OPCODE(0x46, LSR, LSR, ZERO_PAGE, 2, 5, 0) \
+	OPCODE(0x56, LSR, LSR, ZERO_PAGEX, 2, 6, 0) \
+	OPCODE(0x4E, LSR, LSR, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0x5E, LSR, LSR, ABSOLUTEX, 3, 7, 1) \
+	OPCODE(0xEA, NOP, NOP_$EA, IMPLIED, 1, 2, 0) \
+	OPCODE(0x09, ORA, ORA, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0x05, ORA, ORA, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x15, ORA, ORA, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0x0D, ORA, ORA, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x1D, ORA, ORA, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0x19, ORA, ORA, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0x01, ORA, ORA, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0x11, ORA, ORA, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0x48, PHA, PHA_$48, IMPLIED, 1, 3, 0) \
+	OPCODE(0x08, PHP, PHP_$08, IMPLIED, 1, 3, 0) \
+	OPCODE(0x68, PLA, PLA_$68, IMPLIED, 1, 4, 0) \
+	OPCODE(0x28, PLP, PLP_$28, IMPLIED, 1, 4, 0) \
+	OPCODE(0x2A, ROL, ROL, ACCUMULATOR, 1, 2, 0) \
+	OPCODE(0x26, ROL, ROL, ZERO_PAGE, 2, 5, 0) \
+	OPCODE(0x36, ROL, ROL, ZERO_PAGEX, 2, 6, 0) \
+	OPCODE(0x2E, ROL, ROL, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0x3E, ROL, ROL, ABSOLUTEX, 3, 7, 1) \
+	OPCODE(0x6A, ROR, ROR, ACCUMULATOR, 1, 2, 0) \
+	OPCODE(0x66, ROR, ROR, ZERO_PAGE, 2, 5, 0) \
+	OPCODE(0x76, ROR, ROR, ZERO_PAGEX, 2, 6, 0) \
+	OPCODE(0x6E, ROR, ROR, ABSOLUTE, 3, 6, 0) \
+	OPCODE(0x7E, ROR, ROR, ABSOLUTEX, 3, 7, 1) \
+	OPCODE(0x40, RTI, RTI_$40, IMPLIED, 1, 6, 0) \
+	OPCODE(0x60, RTS, RTS_$60, IMPLIED, 1, 6, 0) \
+	OPCODE(0xE9, SBC, SBC, IMMEDIATE, 2, 2, 0) \
+	OPCODE(0xE5, SBC, SBC, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0xF5, SBC, SBC, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0xED, SBC, SBC, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xFD, SBC, SBC, ABSOLUTEX, 3, 4, 1) \
+	OPCODE(0xF9, SBC, SBC, ABSOLUTEY, 3, 4, 1) \
+	OPCODE(0xE1, SBC, SBC, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0xF1, SBC, SBC, INDIRECT_INDEXED, 2, 5, 1) \
+	OPCODE(0x38, SEC, SEC_$38, IMPLIED, 1, 2, 0) \
+	OPCODE(0xF8, SED, SED_$f8, IMPLIED, 1, 2, 0) \
+	OPCODE(0x78, SEI, SEI_$78, IMPLIED, 1, 2, 0) \
+	OPCODE(0x85, STA, STA, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x95, STA, STA, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0x8D, STA, STA, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x9D, STA, STA, ABSOLUTEX, 3, 5, 0) \
+	OPCODE(0x99, STA, STA, ABSOLUTEY, 3, 5, 0) \
+	OPCODE(0x81, STA, STA, INDEXED_INDIRECT, 2, 6, 0) \
+	OPCODE(0x91, STA, STA, INDIRECT_INDEXED, 2, 6, 0) \
+	OPCODE(0x86, STX, STX, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x96, STX, STX, ZERO_PAGEY, 2, 4, 0) \
+	OPCODE(0x8E, STX, STX, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0x84, STY, STY, ZERO_PAGE, 2, 3, 0) \
+	OPCODE(0x94, STY, STY, ZERO_PAGEX, 2, 4, 0) \
+	OPCODE(0x8C, STY, STY, ABSOLUTE, 3, 4, 0) \
+	OPCODE(0xAA, TAX, TAX_$AA, IMPLIED, 1, 2, 0) \
+	OPCODE(0xA8, TAY, TAY_$A8, IMPLIED, 1, 2, 0) \
+	OPCODE(0xBA, TSX, TSX_$BA, IMPLIED, 1, 2, 0) \
+	OPCODE(0x8A, TXA, TXA_$8A, IMPLIED, 1, 2, 0) \
+	OPCODE(0x9A, TXS, TXS_$9A, IMPLIED, 1, 2, 0) \
+	OPCODE(0x98, TYA, TYA_$98, IMPLIED, 1, 2, 0)
+
+	constexpr std::array<InstructionInfo, 256> BuildInstructionTable()
+	{
+		std::array<InstructionInfo, 256> table = {};
+
+#define CONTROLDECK_OPCODE_INFO(opCode, name, handler, mode, bytes, cycles, cyclesPage) \
+		table[opCode] = InstructionInfo{ #name, AdrMode::mode, bytes, cycles, cyclesPage };
+		CONTROLDECK_OPCODES(CONTROLDECK_OPCODE_INFO)
+#undef CONTROLDECK_OPCODE_INFO
+
+		return table;
+	}
+
+	//!< Dense opcode table, indexed directly by opcode - unimplemented opcodes are left as "ERR"/ AdrMode::NONE
+	inline constexpr std::array<InstructionInfo, 256> INSTRUCTION_TABLE = BuildInstructionTable();
+
+	/*	Hot instruction pairs the block cache runs as a single fused handler, PAIR(first, handler, mode, second, handler, mode)
+	*	Copy loops (LDA/ STA), compare & count loops (CMP, DEX/ DEY/ INX/ INY, INC then BNE) and vblank waits (LDA/ BIT $2002 then BPL).
+	*	Cycles & sizes of a fused pair come from INSTRUCTION_TABLE.
+	*/
+#define CONTROLDECK_FUSED_PAIRS(PAIR) \
+	PAIR(0xA9, LDA, IMMEDIATE, 0x85, STA, ZERO_PAGE) \
+	PAIR(0xA9, LDA, IMMEDIATE, 0x8D, STA, ABSOLUTE) \
+	PAIR(0xA9, LDA, IMMEDIATE, 0x9D, STA, ABSOLUTEX) \
+	PAIR(0xA9, LDA, IMMEDIATE, 0x99, STA, ABSOLUTEY) \
+	PAIR(0xA5, LDA, ZERO_PAGE, 0x85, STA, ZERO_PAGE) \
+	PAIR(0xA5, LDA, ZERO_PAGE, 0x8D, STA, ABSOLUTE) \
+	PAIR(0xA5, LDA, ZERO_PAGE, 0x9D, STA, ABSOLUTEX) \
+	PAIR(0xA5, LDA, ZERO_PAGE, 0x99, STA, ABSOLUTEY) \
+	PAIR(0xAD, LDA, ABSOLUTE, 0x85, STA, ZERO_PAGE) \
+	PAIR(0xAD, LDA, ABSOLUTE, 0x8D, STA, ABSOLUTE) \
+	PAIR(0xAD, LDA, ABSOLUTE, 0x9D, STA, ABSOLUTEX) \
+	PAIR(0xAD, LDA, ABSOLUTE, 0x99, STA, ABSOLUTEY) \
+	PAIR(0xBD, LDA, ABSOLUTEX, 0x85, STA, ZERO_PAGE) \
+	PAIR(0xBD, LDA, ABSOLUTEX, 0x8D, STA, ABSOLUTE) \
+	PAIR(0xBD, LDA, ABSOLUTEX, 0x9D, STA, ABSOLUTEX) \
+	PAIR(0xBD, LDA, ABSOLUTEX, 0x99, STA, ABSOLUTEY) \
+	PAIR(0xB9, LDA, ABSOLUTEY, 0x85, STA, ZERO_PAGE) \
+	PAIR(0xB9, LDA, ABSOLUTEY, 0x8D, STA, ABSOLUTE) \
+	PAIR(0xB9, LDA, ABSOLUTEY, 0x9D, STA, ABSOLUTEX) \
+	PAIR(0xB9, LDA, ABSOLUTEY, 0x99, STA, ABSOLUTEY) \
+	PAIR(0xB1, LDA, INDIRECT_INDEXED, 0x85, STA, ZERO_PAGE) \
+	PAIR(0xB1, LDA, INDIRECT_INDEXED, 0x8D, STA, ABSOLUTE) \
+	PAIR(0xB1, LDA, INDIRECT_INDEXED, 0x9D, STA, ABSOLUTEX) \
+	PAIR(0xB1, LDA, INDIRECT_INDEXED, 0x99, STA, ABSOLUTEY) \
+	PAIR(0xC9, CMP, IMMEDIATE, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xC5, CMP, ZERO_PAGE, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xCD, CMP, ABSOLUTE, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xDD, CMP, ABSOLUTEX, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xD9, CMP, ABSOLUTEY, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xCA, DEX_$CA, IMPLIED, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0x88, DEY_$88, IMPLIED, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xE8, INX_$E8, IMPLIED, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xC8, INY_$C8, IMPLIED, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xE6, INC, ZERO_PAGE, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xEE, INC, ABSOLUTE, 0xD0, BNE_D0, RELATIVE) \
+	PAIR(0xAD, LDA, ABSOLUTE, 0x10, BPL_$10, RELATIVE) \
+	PAIR(0x2C, BIT, ABSOLUTE, 0x10, BPL_$10, RELATIVE) \
+
+#define CONTROLDECK_FUSED_PAIR_COUNT(first, firstHandler, firstMode, second, secondHandler, secondMode) + 1
+	inline constexpr uint FUSED_PAIR_COUNT = 0 CONTROLDECK_FUSED_PAIRS(CONTROLDECK_FUSED_PAIR_COUNT);
+#undef CONTROLDECK_FUSED_PAIR_COUNT
+}
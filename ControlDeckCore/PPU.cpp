@@ -0,0 +1,626 @@
+#include "PPU.h"
+#include "CPU.h"
+#include "PPUCtrl.h"
+#include "Palette.h"
+#include "PixelKernels.h"
+
+namespace ControlDeck
+{
+	PPU::PPU(CPU* cpu) : m_tileCache(m_vram.data())
+	{
+		m_cpu = cpu;
+		m_pixelBuffer.resize(FRAME_WIDTH * FRAME_HEIGHT);
+		m_coverage.resize(FRAME_WIDTH * FRAME_HEIGHT);
+		UpdatePalette();
+	}
+
+	// Near black but not black, for pixels that were drawn while rendering was off
+	static const uint STALE_PIXEL_COLOUR = 0x010101;
+
+	// PPUMASK bits that change the colours rather than what's drawn
+	static const uint8 PALETTE_MASK_BITS = (uint8)PPUMask::Greyscale | (uint8)PPUMask::EmphasizeRed | (uint8)PPUMask::EmphasizeGreen | (uint8)PPUMask::EmphasizeBlue;
+
+	// Emphasis dims the channels that aren't emphasised, each set bit attenuates the other two
+	static const double EMPHASIS_ATTENUATION = 0.816328;
+
+	typedef std::array<uint, 64> ColourTable;
+
+	//!< PALETTE for each combination of the emphasis bits, indexed by PPUMASK >> 5 (bit 0 red, 1 green, 2 blue)
+	static std::array<ColourTable, 8> BuildEmphasisPalettes()
+	{
+		std::array<ColourTable, 8> palettes;
+
+		for (uint emphasis = 0; emphasis < palettes.size(); ++emphasis)
+		{
+			for (uint colour = 0; colour < PALETTE.size(); ++colour)
+			{
+				uint result = 0;
+
+				// Channel 0 is red in bits 16 - 23 & pairs with emphasis bit 0, then green & blue
+				for (uint channel = 0; channel < 3; ++channel)
+				{
+					uint shift = 16 - (channel * 8);
+					double level = (PALETTE[colour] >> shift) & 0xFF;
+
+					for (uint other = 0; other < 3; ++other)
+					{
+						if (other != channel && (emphasis & (1 << other)))
+						{
+							level *= EMPHASIS_ATTENUATION;
+						}
+					}
+
+					result |= (uint)level << shift;
+				}
+
+				palettes[emphasis][colour] = result;
+			}
+		}
+
+		return palettes;
+	}
+
+	static const std::array<ColourTable, 8> EMPHASIS_PALETTES = BuildEmphasisPalettes();
+
+	void PPU::SetRenderEnabled(bool enabled)
+	{
+		if (enabled == m_renderEnabled)
+		{
+			return;
+		}
+
+		m_renderEnabled = enabled;
+
+		if (!enabled)
+		{
+			for (size_t i = 0; i < m_pixelBuffer.size(); ++i)
+			{
+				m_coverage[i] = m_pixelBuffer[i] != 0;
+			}
+		}
+		else
+		{
+			// Pixels the next frame doesn't draw over are stale either way, only their black/ not black has to carry over
+			for (size_t i = 0; i < m_pixelBuffer.size(); ++i)
+			{
+				if ((m_pixelBuffer[i] != 0) != (m_coverage[i] != 0))
+				{
+					m_pixelBuffer[i] = m_coverage[i] ? STALE_PIXEL_COLOUR : 0;
+				}
+			}
+		}
+	}
+
+	void PPU::Update()
+	{
+		RunDots(1);
+	}
+
+	void PPU::Run(uint cycles)
+	{
+		// Whole scanlines when called on a line boundary, otherwise up to the end of the current line first
+		while (cycles > 0)
+		{
+			uint dots = std::min(cycles, CYCLES_PER_SCANLINE - m_currentCycle);
+			RunDots(dots);
+			cycles -= dots;
+		}
+	}
+
+	void PPU::CatchUp(uint64 masterClock)
+	{
+		if (m_catchingUp || masterClock <= m_timestamp)
+		{
+			return;
+		}
+
+		uint cycles = (uint)((masterClock - m_timestamp) / MASTER_CLOCK_DIVIDER);
+		m_timestamp += (uint64)cycles * MASTER_CLOCK_DIVIDER;
+
+		m_catchingUp = true;
+		Run(cycles);
+		m_catchingUp = false;
+	}
+
+	void PPU::RunDots(uint dots)
+	{
+		if (dots == 0)
+		{
+			return;
+		}
+
+		const uint start = m_currentCycle;
+		const uint end = start + dots;
+
+		if (m_currentScanline < 240)
+		{
+			if (m_currentScanline % 8 == 0)
+			{
+				// Tile row at every 8th dot of the visible part of the line
+				for (m_currentCycle = (start + 7) & ~7u; m_currentCycle < end && m_currentCycle < 256; m_currentCycle += 8)
+				{
+					DrawTileAtCycle();
+				}
+
+				if (m_currentScanline != 0 && start <= 256 && end > 256)
+				{
+					m_currentCycle = 256;
+					DrawSprites();
+				}
+			}
+
+			/// OAMADDR is set to 0 257-320 of pre-render and visible scanlines
+		}
+		else if (m_currentScanline == 241 && start <= 1 && end > 1)
+		{
+			m_currentCycle = 1;
+			SetVblank();
+		}
+		else if (m_currentScanline == 261 && start <= 1 && end > 1)
+		{
+			m_currentCycle = 1;
+			ClearVblank();
+		}
+
+		if (m_currentScanline == 260 && start == 0)
+		{
+			m_frameCount++;
+		}
+
+		// Last dot run, IncrementCycle wraps onto the next line when it was the line's last
+		m_currentCycle = end - 1;
+		IncrementCycle();
+	}
+
+	void PPU::WriteOAMByte(uint8 addr, uint8 data)
+	{
+		m_primaryOAM[addr] = data;
+	}
+
+	void PPU::WriteMemory8(uint16 Addr, uint8 Data)
+	{
+		Addr &= VRAM_ADDRESS_MASK;
+		m_vram[Addr] = Data;
+		m_tileCache.Invalidate(Addr);
+
+		// if vertical mirroring, : $2000 equals $2800 and $2400 equals $2C00 
+		if (true)
+		{	
+			if (Addr >= 0x2000 && Addr <= 0x23ff)
+			{
+				m_vram[Addr + 0x800] = Data;
+			}
+
+			if (Addr >= 0x2800 && Addr <= 0x2bff)
+			{
+				m_vram[Addr - 0x800] = Data;
+			}
+
+			if (Addr >= 0x2400 && Addr <= 0x27ff)
+			{
+				m_vram[Addr + 0x800] = Data;
+			}
+
+			if (Addr >= 0x2C00 && Addr <= 0x2fff)
+			{
+				m_vram[Addr - 0x800] = Data;
+			}
+
+		}
+
+		//$3000 - $3EFF	$0F00	Mirrors of $2000 - $2EFF
+		if (Addr >= 0x3000 && Addr <= 0x3EFF)
+		{
+			m_vram[Addr - 0x1000] = Data;
+		}
+
+		if (Addr >= 0x2000 && Addr < 0x2EFF)
+		{
+			m_vram[Addr + 0x1000] = Data;
+		}
+
+		// Addresses $3F10/$3F14/$3F18/$3F1C are mirrors of $3F00/$3F04/$3F08/$3F0C
+		if (Addr == 0x3F10 || Addr == 0x3F00)
+		{
+			m_vram[0x3F10] = Data;
+			m_vram[0x3F00] = Data;
+		}
+
+		else if (Addr == 0x3F14 || Addr == 0x3F04)
+		{
+			m_vram[0x3F14] = Data;
+			m_vram[0x3F04] = Data;
+		}
+
+		else if (Addr == 0x3F18 || Addr == 0x3F08)
+		{
+			m_vram[0x3F18] = Data;
+			m_vram[0x3F08] = Data;
+		}
+
+		else if (Addr == 0x3F1C || Addr == 0x3F0C)
+		{
+			m_vram[0x3F1C] = Data;
+			m_vram[0x3F0C] = Data;
+		}
+
+		if (Addr >= PALETTE_ADR && Addr < PALETTE_ADR + m_palette.size())
+		{
+			UpdatePalette();
+		}
+	}
+
+	void PPU::UpdatePalette()
+	{
+		m_paletteMask = m_ppuMask & PALETTE_MASK_BITS;
+
+		// Palette RAM entries are 6 bits, greyscale keeps only the brightness row of the 16 x 4 colour grid
+		const ColourTable& colours = EMPHASIS_PALETTES[m_ppuMask >> 5];
+		uint8 indexMask = (m_ppuMask & (uint8)PPUMask::Greyscale) ? 0x30 : 0x3F;
+
+		for (uint entry = 0; entry < m_palette.size(); ++entry)
+		{
+			m_palette[entry] = colours[m_vram[PALETTE_ADR + entry] & indexMask];
+		}
+	}
+
+	void PPU::LoadRegistersFromCPU()
+	{
+		m_ppuCTRL = m_cpu->m_ppuRegisters[PPU_CTRL_ADR & CPU::PPU_REGISTER_MASK];
+		m_ppuMask = m_cpu->m_ppuRegisters[PPU_MASK_ADR & CPU::PPU_REGISTER_MASK];
+		m_oamAddr = m_cpu->m_ppuRegisters[OAM_ADR & CPU::PPU_REGISTER_MASK];
+
+		if ((m_ppuMask & PALETTE_MASK_BITS) != m_paletteMask)
+		{
+			UpdatePalette();
+		}
+	}
+
+	uint8 PPU::ReadMemory8(uint16 Addr, bool memoryMappedIO)
+	{
+		Addr &= VRAM_ADDRESS_MASK;
+
+		if (Addr <= 0X3EFF )
+		{
+			uint data = m_readBuffer;
+			m_readBuffer = m_vram[Addr];
+
+			if (memoryMappedIO)
+			{
+				return data;
+			}
+		}
+
+		return m_vram[Addr];
+	}
+
+	void PPU::SetPPUCtrl(PPUCtrl status, bool bEnabled)
+	{
+		if (bEnabled)
+		{
+			m_ppuCTRL |= (uint8)status;
+		}
+		else
+		{
+			m_ppuCTRL &= ~(uint8)status;
+		}
+
+		m_cpu->WriteMemory8(PPU_CTRL_ADR, m_ppuCTRL);
+	}
+
+	void PPU::SetPPUStatus(PPUStatus status, bool bEnabled)
+	{
+		if (bEnabled)
+		{
+			m_ppuStatus |= (uint8)status;
+		}
+		else
+		{
+			m_ppuStatus &= ~(uint8)status;
+		}
+
+		m_cpu->WriteMemory8(PPU_STATUS_ADR, m_ppuStatus);
+	}
+
+	uint8 PPU::GetBackgroundPaletteIndex()
+	{
+		// If bit 6 of PPUCTRL is clear the ppu gets the palette index for background from EXT pins, stock NES grounds these pins resulting in 0
+		if ((m_ppuCTRL & (uint8)PPUCtrl::PPUMasterSlaveSelect) == 0)
+		{
+			return 0;
+		}
+
+		return uint8();
+	}
+
+	void PPU::LoadSpritesForScanline(uint scanline )
+	{
+		uint8 spriteHeight = 8;
+		uint8 spritePosY = 0;
+
+		std::fill(m_secondaryOAM.begin(), m_secondaryOAM.end(), 0);
+		m_totalSprites = 0;
+
+		if (m_ppuCTRL & (uint8)PPUCtrl::SpriteSize)
+		{
+			spriteHeight = 16;
+		}
+
+		for (uint16 i = 0; i <= 0xFF; i += 4)
+		{
+			spritePosY = m_primaryOAM[i];
+
+			if (std::abs((int)spritePosY - (int)scanline) <= 8)
+			{
+				if (m_totalSprites >= 8)
+				{
+					// Set overflow and exit.
+					SetPPUStatus(PPUStatus::SpriteOverflow, true);
+					break;
+				}
+
+				// Load sprite into secondary OAM
+				for (uint8 p = 0; p < 4; ++p)
+				{
+					m_secondaryOAM[(m_totalSprites * 4) + p] = m_primaryOAM[i + p];
+				}
+				m_totalSprites++;
+			}
+		}
+	}
+
+	void PPU::IncrementCycle()
+	{
+		m_currentCycle++;
+
+		if (m_currentCycle > 340)
+		{
+			m_currentCycle = 0;
+			m_currentScanline++;
+
+			if (m_currentScanline > 261)
+			{
+				m_currentScanline = 0;
+			}
+		}
+	}
+
+	uint PPU::GetCyclesToNextEvent() const
+	{
+		const uint frameCycles = CYCLES_PER_SCANLINE * SCANLINES_PER_FRAME;
+		const uint position = (m_currentScanline * CYCLES_PER_SCANLINE) + m_currentCycle;
+
+		// SetVblank at 241/1, ClearVblank at 261/1
+		uint next = (241 * CYCLES_PER_SCANLINE) + 1;
+		if (position >= next)
+		{
+			next = (261 * CYCLES_PER_SCANLINE) + 1;
+		}
+
+		if (position >= next)
+		{
+			next = frameCycles + (8 * CYCLES_PER_SCANLINE) + 256;
+		}
+
+		// DrawSprites runs at cycle 256 of every 8th visible scanline
+		for (uint scanline = 8; scanline < 240; scanline += 8)
+		{
+			uint sprites = (scanline * CYCLES_PER_SCANLINE) + 256;
+
+			if (sprites > position)
+			{
+				next = std::min(next, sprites);
+				break;
+			}
+		}
+
+		return next - position;
+	}
+
+	void PPU::SetVblank()
+	{
+		if (m_currentScanline == 241 && m_currentCycle == 1)
+		{
+			/// OAMADDR is set to 0 257-320 of pre-render and visible scanlines
+			m_oamAddr = 0;
+			m_cpu->WriteMemory8(OAM_ADR, m_oamAddr);
+			LoadRegistersFromCPU();
+
+
+			//SetPPUCtrl(PPUCtrl::VerticalBlanking, true);
+			SetPPUStatus(PPUStatus::VerticalBlank, true);
+			m_cpu->setNMI(true);
+		}
+	}
+
+	void PPU::ClearVblank()
+	{
+		if (m_currentScanline == 261 && m_currentCycle == 1)
+		{
+			//SetPPUStatus(PPUStatus::VerticalBlank, false);
+			m_cpu->setNMI(false);
+		}
+	}
+
+	uint16 PPU::GetNametableAddress()
+	{
+		uint8 nametable = m_ppuCTRL & 0x3;
+
+		switch (nametable)
+		{
+			case 0: return 0x2000;
+			case 1: return 0x2400;
+			case 2: return 0x2800;
+			case 3: return 0x2C00;
+		}
+		
+		return 0x2000;
+	}
+
+	void PPU::DrawTileAtCycle()
+	{
+		m_currentTile = (m_currentCycle / 8) + ((m_currentScanline / 8) * 32);
+		m_currentTile += m_coarseX;
+		m_currentTile += m_coarseY * 32;
+		DrawTile();
+	}
+
+	void PPU::DrawTile()
+	{
+		//Load nametable byte, nametable byte holds index into pattern table
+		uint8 nameTableByte = ReadMemory8(GetNametableAddress() + m_currentTile);
+		uint16 patternAddress = (m_ppuCTRL & (uint8)PPUCtrl::BackgroundPatternAddress) ? 0x1000 : 0x0;
+
+		uint8 tileX = (m_currentCycle / 32);
+		uint8 tileY = m_currentScanline / 32;
+		
+		uint8 subTileX = (m_currentCycle / 8) % 4 < 2 ? 0 : 1;
+		uint8 subTileY = (m_currentScanline / 8) % 4 < 2 ? 0 : 1;
+
+		uint8 attributeTable = ReadMemory8(GetNametableAddress() + ATTRIB_OFFSET + (tileX + (tileY * 8)));
+		uint8 paletteIndex = (attributeTable >> ((subTileX * 2) + (subTileY * 4))) & 0x3;
+
+		uint16 tileAddress = patternAddress + (nameTableByte * 16);
+
+		// Backdrop colour for index 0, the attribute's palette for 1 - 3
+		uint colours[4];
+		colours[0] = m_palette[0];
+		for (uint8 pixel = 1; pixel < 4; ++pixel)
+		{
+			colours[pixel] = m_palette[(paletteIndex * 4) + pixel];
+		}
+
+		for (int i = 0; i < 8; ++i)
+		{
+			// Write to buffer, scanline + i = y m_currentCycle + p = x
+			uint8 posY = m_currentScanline + i + m_scrollY;
+
+			if (posY >= 240)
+			{
+				continue;
+			}
+
+			const uint8* row = m_tileCache.GetRow(tileAddress, i);
+
+			if (m_renderEnabled)
+			{
+				uint* line = &m_pixelBuffer[posY * 256];
+				uint8 posX = m_currentCycle + m_scrollX;
+
+				// One 8 pixel store unless the row wraps around the right edge
+				if (posX <= 256 - 8)
+				{
+					Pixels::MapRow(row, colours, line + posX);
+				}
+				else
+				{
+					for (int p = 0; p < 8; ++p)
+					{
+						line[(uint8)(posX + p)] = colours[row[p]];
+					}
+				}
+			}
+			else
+			{
+				// Only black/ not black is needed for sprite 0 hit
+				uint8* line = &m_coverage[posY * 256];
+				for (int p = 0; p < 8; ++p)
+				{
+					line[(uint8)(m_currentCycle + p + m_scrollX)] = colours[row[p]] != 0;
+				}
+			}
+		}
+
+		// Pattern reads through ReadMemory8 leave the high plane of the tile's last row in the PPUDATA read buffer
+		m_readBuffer = m_vram[tileAddress + 7 + 8];
+	}
+
+	void PPU::DrawSprites()
+	{
+		uint16 patternAddress = (m_ppuCTRL & (uint8)PPUCtrl::SpritePatternAddress) ? 0x1000 : 0x0;
+		uint16 lastAddress = 0;
+		bool spriteRead = false;
+		bool spriteHit = false;
+
+		// draw 8 previous scanlines
+		for (uint scanline = 0; scanline < 8; scanline++)
+		{
+			uint currentScanline = m_currentScanline - 8 + scanline;
+
+			// Todo add sprite priority - front back sorting
+			LoadSpritesForScanline(currentScanline);
+
+			// For each of the total number of sprites up to 8, sprites selected for this scanline
+			for (uint p = 0; p < m_totalSprites; ++p)
+			{
+				uint8 yPosition = m_secondaryOAM[p * 4] + 1;
+				uint8 xPosition = m_secondaryOAM[(p * 4) + 3];
+				uint8 patternOffset = m_secondaryOAM[(p * 4) + 1];
+				uint8 paletteIndex = m_secondaryOAM[(p * 4) + 2] & 0x3;
+				bool flipX = m_secondaryOAM[(p * 4) + 2] & 0x40;
+
+				// if 8x8 sprite byte 1 indicates pattern table tile index
+				if (m_ppuCTRL & (uint8)PPUCtrl::SpriteSize)
+				{
+					printf("Error: Unsupported sprite size 16x");
+					throw("DIE");
+				}
+
+				uint16 tileAddress = patternAddress + (patternOffset * 16);
+				lastAddress = tileAddress + scanline;
+				spriteRead = true;
+
+				uint colours[4] = {};
+				for (uint8 pixel = 1; pixel < 4; ++pixel)
+				{
+					colours[pixel] = m_palette[((4 + paletteIndex) * 4) + pixel];
+				}
+
+				// Flipped sprites have always landed one pixel right of unflipped ones
+				const uint8* row = m_tileCache.GetRow(tileAddress, scanline, flipX);
+				uint start = xPosition + (flipX ? 1 : 0) + ((yPosition + scanline) * 256);
+
+				// Sprite 0 hit on any sprite pixel over a non black one
+				if (m_renderEnabled && start + 8 <= m_pixelBuffer.size())
+				{
+					spriteHit |= Pixels::BlendSpriteRow(row, colours, &m_pixelBuffer[start]);
+					continue;
+				}
+
+				for (int q = 0; q < 8; ++q)
+				{
+					uint8 pixel = row[q];
+					uint pos = start + q;
+
+					if (pixel == 0 || pos >= m_pixelBuffer.size())
+					{
+						continue;
+					}
+
+					if (m_renderEnabled)
+					{
+						spriteHit |= m_pixelBuffer[pos] != 0;
+						m_pixelBuffer[pos] = colours[pixel];
+					}
+					else
+					{
+						spriteHit |= m_coverage[pos] != 0;
+						m_coverage[pos] = colours[pixel] != 0;
+					}
+				}
+			}
+		}
+
+		// Setting the flag again within one call changes nothing, once is enough
+		if (spriteHit)
+		{
+			SetPPUStatus(PPUStatus::Sprite0Hit, true);
+		}
+
+		// Pattern reads through ReadMemory8 leave the last sprite row's high plane in the PPUDATA read buffer
+		if (spriteRead)
+		{
+			m_readBuffer = m_vram[(lastAddress + 8) & VRAM_ADDRESS_MASK];
+		}
+	}
+}
\ No newline at end of file
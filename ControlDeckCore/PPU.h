@@ -0,0 +1,199 @@
+#pragma once
+#include "Common.h"
+#include "PPUCtrl.h"
+#include "PPUStatus.h"
+#include "PPUMask.h"
+#include "TileCache.h"
+
+//PPU Memory
+//Address range	Size	Description
+//$0000 - $0FFF	$1000	Pattern table 0
+//$1000 - $1FFF	$1000	Pattern table 1
+//$2000 - $23FF	$0400	Nametable 0
+//$2400 - $27FF	$0400	Nametable 1
+//$2800 - $2BFF	$0400	Nametable 2
+//$2C00 - $2FFF	$0400	Nametable 3
+//$3000 - $3EFF	$0F00	Mirrors of $2000 - $2EFF
+//$3F00 - $3F1F	$0020	Palette RAM indexes
+//$3F20 - $3FFF	$00E0	Mirrors of $3F00 - $3F1F
+namespace ControlDeck
+{
+	class CPU;
+
+	/*	PPUState - VRAM, OAM, registers & position in the frame, a plain struct so it can be copied in one go
+	*	The pixel buffer is output rather than state, it is fully redrawn every frame & stays in PPU.
+	*/
+	struct PPUState
+	{
+		//!< Master clock time the PPU has been run up to
+		uint64 m_timestamp = 0;
+
+		// Frames presented, bumped on scanline 260 dot 0
+		uint64 m_frameCount = 0;
+
+		uint m_currentCycle = 0;
+		uint m_currentScanline = 0;
+		uint m_currentTile = 0;
+
+		// Number of sprites found for scanline.
+		uint m_totalSprites = 0;
+
+		uint8 m_ppuCTRL = 0;
+		uint8 m_ppuMask = 0;
+		uint8 m_ppuStatus = 0;
+		uint8 m_oamAddr = 0;
+		uint8 m_oamData = 0;
+		uint8 m_ppuScroll = 0;
+		uint8 m_ppuAddr = 0;
+		uint8 m_ppuData = 0;
+		uint8 m_oamDMA = 0;
+
+		//!< PPUDATA read buffer - reads below the palettes return the previous byte
+		uint8 m_readBuffer = 0;
+
+		uint8 m_scrollX = 0;
+		uint8 m_scrollY = 0;
+		uint8 m_coarseX = 0;
+		uint8 m_coarseY = 0;
+
+		//!< Explicit padding, see the static_assert below
+		uint8 m_reserved[2] = {};
+
+		// 64 bytes OAM - holds 8 sprites for the current scanline.
+		std::array<uint8, 0x20> m_secondaryOAM = {};
+
+		// 256 bytes OAM - Object arribute memory, holds 64 sprites, each sprite is 4 bytes
+		std::array<uint8, 0x100> m_primaryOAM = {};
+
+		// 16 kb address space used by ppu, addresses are masked with VRAM_ADDRESS_MASK
+		std::array<uint8, 0x4000> m_vram = {};
+	};
+
+	//!< No padding bytes, equal states have to serialise to equal bytes for save state comparison & deltas
+	static_assert(std::has_unique_object_representations<PPUState>::value, "PPUState has padding");
+
+	// 262 scanlines per frame 
+	// 1 scaneline == 341 ppu clock cycles - 1CPU = 3 PPU
+	class PPU : private PPUState
+	{
+		friend class CPU;
+	public:
+		PPU() = delete;
+		PPU(CPU* cpu);
+
+		//!< Steps a single PPU cycle (dot)
+		void Update();
+
+		//!< Steps the given number of PPU cycles (dots), a scanline or the part of one up to a CPU register access at a time
+		void Run(uint cycles);
+
+		//!< Runs the PPU up to masterClock from where it was last left, re-entrant calls from the PPU's own register writes are ignored
+		void CatchUp(uint64 masterClock);
+
+		uint64 GetTimestamp() const { return m_timestamp; }
+		void SetTimestamp(uint64 masterClock) { m_timestamp = masterClock; }
+
+		//!< PPU is clocked once every 4 NTSC master clock cycles
+		static const uint MASTER_CLOCK_DIVIDER = 4;
+		void WriteOAMByte(uint8 addr, uint8 data);
+		void WriteMemory8(uint16 Addr, uint8 Data);
+
+		uint GetPPUCycles() const { return m_currentCycle; }
+
+		//!< 256x240 frame, one 0RGB pixel per uint - complete once GetFrameCount() has moved on, i.e. after Scheduler::RunFrame()
+		const std::vector<uint>& GetFrameBuffer() const { return m_pixelBuffer; }
+		uint64 GetFrameCount() const { return m_frameCount; }
+
+		static const uint FRAME_WIDTH = 256;
+		static const uint FRAME_HEIGHT = 240;
+
+		/*	Rendering off skips the palette lookups & framebuffer writes for frames that won't be shown (fast forward, run
+		*	ahead). Timing, VBlank/ NMI, sprite overflow & sprite 0 hit are unchanged - sprite 0 hit tests the framebuffer for
+		*	non black pixels, so a byte per pixel of coverage is kept instead. Switch between frames, the framebuffer is
+		*	stale after a frame with rendering off.
+		*/
+		void SetRenderEnabled(bool enabled);
+		bool IsRenderEnabled() const { return m_renderEnabled; }
+
+		//!< PPU cycles until the next point the CPU can observe a change - vblank set/ clear or a sprite draw that may set sprite 0 hit
+		uint GetCyclesToNextEvent() const;
+
+		static const uint CYCLES_PER_SCANLINE = 341;
+		static const uint SCANLINES_PER_FRAME = 262;
+
+		//!< The PPU address bus is 14 bits, $4000 - $FFFF mirror $0000 - $3FFF
+		static const uint16 VRAM_ADDRESS_MASK = 0x3FFF;
+
+		const PPUState& GetState() const { return *this; }
+		void SetState(const PPUState& state) { static_cast<PPUState&>(*this) = state; m_tileCache.InvalidateAll(); UpdatePalette(); }
+
+		// Copies memory mapped registers between CPU <--> PPU 
+		void LoadRegistersFromCPU();
+
+	private:
+		uint8 ReadMemory8(uint16 Addr, bool memoryMappedIO = false);
+
+
+		void SetPPUStatus(PPUStatus, bool bEnabled);
+		void SetPPUCtrl(PPUCtrl status, bool bEnabled);
+		uint8 GetBackgroundPaletteIndex();
+
+		//!< Resolves the 32 palette RAM entries at $3F00 - $3F1F into m_palette, through the emphasis & greyscale of m_ppuMask
+		void UpdatePalette();
+		uint8 ReadBufferedByte() {}
+
+		// Loads 8 sprites for current scanline into secondary oam
+		void LoadSpritesForScanline(uint scanline);
+
+		void IncrementCycle();
+
+		/*	Runs dots PPU cycles without leaving the current scanline, dots up to the end of the line wraps onto the next.
+		*	Jumps straight between the dots where something happens - the tile row draws on every 8th visible scanline, the
+		*	sprite draw at dot 256 & vblank set/ clear - so a whole line costs the same as a few dots.
+		*/
+		void RunDots(uint dots);
+		void DrawTileAtCycle();
+		void SetVblank();
+		void ClearVblank();
+		uint16 GetNametableAddress();
+		void DrawTile();
+		void DrawSprites();
+
+		// Pixel buffer to be "blitted" to screen by the frontend
+		std::vector<uint> m_pixelBuffer;
+
+		//!< Stands in for m_pixelBuffer while rendering is off, 1 where the pixel would not be black
+		std::vector<uint8> m_coverage;
+		bool m_renderEnabled = true;
+
+		//!< Decoded pattern tables, derived from m_vram so not part of the state
+		TileCache m_tileCache;
+
+		//!< Colour of each palette RAM entry, derived from m_vram so not part of the state. 0 - 15 background, 16 - 31 sprites
+		std::array<uint, 32> m_palette = {};
+
+		//!< Emphasis & greyscale bits of m_ppuMask that m_palette was resolved with
+		uint8 m_paletteMask = 0;
+
+		CPU* m_cpu = nullptr;
+		bool m_catchingUp = false;
+
+		// PPU RAM ADDRESS START LOCATIONS
+		const uint16 NAMETABLE_ADR = 0x2000;
+		const uint16 ATTRIB_OFFSET = 0x3C0;
+		const uint16 PALETTE_ADR = 0x3F00;
+		const uint16 PALETTE_SPRITE_ADR = 0x3F11;
+
+		// CPU ADDRESS LOCATIONS
+		// https://wiki.nesdev.com/w/index.php/PPU_registers#OAMADDR
+		const uint16 PPU_CTRL_ADR = 0x2000;
+		const uint16 PPU_MASK_ADR = 0x2001;
+		const uint16 PPU_STATUS_ADR = 0x2002;
+		const uint16 OAM_ADR = 0x2003;
+		const uint16 OAM_DATA_ADR = 0x2004;
+		const uint16 PPU_SCROLL_ADR = 0x2005;
+		const uint16 PPU_ADR = 0x2006;
+		const uint16 PPU_DATA_ADR = 0x2007;
+		const uint16 OAM_DMA_ADR = 0x4014;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Common.h"
+
+#if defined(__AVX2__)
+#define CONTROLDECK_PIXELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTROLDECK_PIXELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ControlDeck
+{
+	/*	Pixels - 8 pixel kernels for the PPU's tile & sprite rows
+	*	AVX2 when the compiler targets it (/arch:AVX2, -mavx2), SSE2 on any x86-64 build, otherwise the scalar versions.
+	*	The scalar versions are always available as the reference & for the pixel benchmark in the headless runner.
+	*/
+	namespace Pixels
+	{
+		//!< Name of the kernels compiled in
+		inline const char* GetKernelName()
+		{
+#if defined(CONTROLDECK_PIXELS_AVX2)
+			return "AVX2";
+#elif defined(CONTROLDECK_PIXELS_SSE2)
+			return "SSE2";
+#else
+			return "scalar";
+#endif
+		}
+
+		//!< Expands a pattern row's two bit planes into 8 colour indices (0 - 3), bit 7 is the leftmost pixel unless flipped
+		inline void DecodeRowScalar(uint8 low, uint8 high, bool flipX, uint8* indices)
+		{
+			for (uint p = 0; p < 8; ++p)
+			{
+				uint shift = flipX ? p : 7 - p;
+				indices[p] = (((high >> shift) & 0x1) << 1) | ((low >> shift) & 0x1);
+			}
+		}
+
+		//!< 8 colour indices to 8 pixels through a 4 entry colour table
+		inline void MapRowScalar(const uint8* indices, const uint* colours, uint* out)
+		{
+			for (uint p = 0; p < 8; ++p)
+			{
+				out[p] = colours[indices[p]];
+			}
+		}
+
+		//!< Draws 8 sprite pixels over dst, index 0 is transparent. True when an opaque pixel lands on a non black one
+		inline bool BlendSpriteRowScalar(const uint8* indices, const uint* colours, uint* dst)
+		{
+			bool hit = false;
+
+			for (uint p = 0; p < 8; ++p)
+			{
+				if (indices[p] != 0)
+				{
+					hit |= dst[p] != 0;
+					dst[p] = colours[indices[p]];
+				}
+			}
+
+			return hit;
+		}
+
+#if defined(CONTROLDECK_PIXELS_SSE2) || defined(CONTROLDECK_PIXELS_AVX2)
+		inline void DecodeRow(uint8 low, uint8 high, bool flipX, uint8* indices)
+		{
+			// Each byte lane tests its own bit of the broadcast planes
+			const __m128i bits = flipX ? _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0, 0, 0, 0, 0, 0, 0, 0)
+				: _mm_setr_epi8((char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0, 0, 0, 0, 0, 0, 0, 0);
+
+			__m128i lowSet = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((char)low), bits), bits);
+			__m128i highSet = _mm_cmpeq_epi8(_mm_and_si128(_mm_set1_epi8((char)high), bits), bits);
+			__m128i result = _mm_or_si128(_mm_and_si128(lowSet, _mm_set1_epi8(1)), _mm_and_si128(highSet, _mm_set1_epi8(2)));
+
+			_mm_storel_epi64((__m128i*)indices, result);
+		}
+#else
+		inline void DecodeRow(uint8 low, uint8 high, bool flipX, uint8* indices) { DecodeRowScalar(low, high, flipX, indices); }
+#endif
+
+#if defined(CONTROLDECK_PIXELS_AVX2)
+		//!< 8 indices widened to 32 bit lanes
+		inline __m256i LoadIndices(const uint8* indices)
+		{
+			return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)indices));
+		}
+
+		//!< Both 128 bit halves hold the 4 colours so the permute's lane index only needs the low 2 bits
+		inline __m256i LoadColours(const uint* colours)
+		{
+			return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)colours));
+		}
+
+		inline void MapRow(const uint8* indices, const uint* colours, uint* out)
+		{
+			_mm256_storeu_si256((__m256i*)out, _mm256_permutevar8x32_epi32(LoadColours(colours), LoadIndices(indices)));
+		}
+
+		inline bool BlendSpriteRow(const uint8* indices, const uint* colours, uint* dst)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			__m256i index = LoadIndices(indices);
+			__m256i colour = _mm256_permutevar8x32_epi32(LoadColours(colours), index);
+			__m256i existing = _mm256_loadu_si256((const __m256i*)dst);
+
+			__m256i transparent = _mm256_cmpeq_epi32(index, zero);
+			__m256i black = _mm256_cmpeq_epi32(existing, zero);
+
+			_mm256_storeu_si256((__m256i*)dst, _mm256_blendv_epi8(colour, existing, transparent));
+			return _mm256_movemask_epi8(_mm256_or_si256(transparent, black)) != -1;
+		}
+#elif defined(CONTROLDECK_PIXELS_SSE2)
+		//!< 4 indices widened to 32 bit lanes
+		inline __m128i LoadIndices(const uint8* indices)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			int packed;
+			memcpy(&packed, indices, sizeof(packed));
+			return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+		}
+
+		//!< No variable 32 bit shuffle in SSE2, each of the 4 colours is selected by compare
+		inline __m128i SelectColours(__m128i index, const uint* colours)
+		{
+			__m128i result = _mm_and_si128(_mm_cmpeq_epi32(index, _mm_setzero_si128()), _mm_set1_epi32((int)colours[0]));
+			result = _mm_or_si128(result, _mm_and_si128(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)), _mm_set1_epi32((int)colours[1])));
+			result = _mm_or_si128(result, _mm_and_si128(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)), _mm_set1_epi32((int)colours[2])));
+			return _mm_or_si128(result, _mm_and_si128(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)), _mm_set1_epi32((int)colours[3])));
+		}
+
+		inline void MapRow(const uint8* indices, const uint* colours, uint* out)
+		{
+			_mm_storeu_si128((__m128i*)out, SelectColours(LoadIndices(indices), colours));
+			_mm_storeu_si128((__m128i*)(out + 4), SelectColours(LoadIndices(indices + 4), colours));
+		}
+
+		inline bool BlendSpriteRow(const uint8* indices, const uint* colours, uint* dst)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			int keep = 0xFFFF;
+
+			for (uint half = 0; half < 8; half += 4)
+			{
+				__m128i index = LoadIndices(indices + half);
+				__m128i existing = _mm_loadu_si128((const __m128i*)(dst + half));
+				__m128i transparent = _mm_cmpeq_epi32(index, zero);
+				__m128i colour = _mm_andnot_si128(transparent, SelectColours(index, colours));
+
+				_mm_storeu_si128((__m128i*)(dst + half), _mm_or_si128(colour, _mm_and_si128(transparent, existing)));
+				keep &= _mm_movemask_epi8(_mm_or_si128(transparent, _mm_cmpeq_epi32(existing, zero)));
+			}
+
+			return keep != 0xFFFF;
+		}
+#else
+		inline void MapRow(const uint8* indices, const uint* colours, uint* out) { MapRowScalar(indices, colours, out); }
+		inline bool BlendSpriteRow(const uint8* indices, const uint* colours, uint* dst) { return BlendSpriteRowScalar(indices, colours, dst); }
+#endif
+	}
+}
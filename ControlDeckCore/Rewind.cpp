@@ -0,0 +1,195 @@
+#include "Rewind.h"
+#include "Console.h"
+#include <algorithm>
+
+namespace ControlDeck
+{
+	// Zero runs shorter than this are cheaper to keep inside a literal than to split it
+	static const size_t MIN_ZERO_RUN = 4;
+
+	Rewind::Rewind(size_t memoryBudget, uint keyframeInterval)
+	{
+		m_memoryBudget = memoryBudget;
+		m_keyframeInterval = std::max(1u, keyframeInterval);
+	}
+
+	void Rewind::Push(const Console& console)
+	{
+		console.SaveState(m_state);
+
+		uint distance = m_snapshots.empty() || !m_keyframeValid ? 0 : m_snapshots.back().KeyframeDistance + 1;
+		if (distance >= m_keyframeInterval)
+		{
+			distance = 0;
+		}
+
+		if (distance == 0)
+		{
+			Encode(m_state.data(), nullptr, m_encoded);
+			m_keyframe = m_state;
+			m_keyframeValid = true;
+		}
+		else
+		{
+			Encode(m_state.data(), m_keyframe.data(), m_encoded);
+		}
+
+		m_snapshots.push_back({ std::vector<uint8>(m_encoded.begin(), m_encoded.end()), distance });
+		m_memoryUsed += m_encoded.size();
+
+		Trim();
+	}
+
+	bool Rewind::StepBack(Console& console)
+	{
+		if (m_snapshots.empty())
+		{
+			return false;
+		}
+
+		const Snapshot& snapshot = m_snapshots.back();
+		const Snapshot& keyframe = m_snapshots[m_snapshots.size() - 1 - snapshot.KeyframeDistance];
+
+		m_state.assign(SAVE_STATE_SIZE, 0);
+		Decode(keyframe.Data, m_state.data());
+		if (snapshot.KeyframeDistance != 0)
+		{
+			Decode(snapshot.Data, m_state.data());
+		}
+
+		bool loaded = console.LoadState(m_state);
+
+		// m_keyframe still belongs to the newest group unless its keyframe is the one popped, the next push starts a new group then
+		if (snapshot.KeyframeDistance == 0)
+		{
+			m_keyframeValid = false;
+		}
+
+		m_memoryUsed -= snapshot.Data.size();
+		m_snapshots.pop_back();
+
+		return loaded;
+	}
+
+	void Rewind::Clear()
+	{
+		m_snapshots.clear();
+		m_memoryUsed = 0;
+		m_keyframeValid = false;
+	}
+
+	void Rewind::SetMemoryBudget(size_t memoryBudget)
+	{
+		m_memoryBudget = memoryBudget;
+		Trim();
+	}
+
+	void Rewind::Encode(const uint8* state, const uint8* base, std::vector<uint8>& out)
+	{
+		/*	Sequence of [zero run, literal length, literal bytes] records, runs & lengths are uint16 as a state is < 64KB
+		*	Trailing zeroes are implied by the state size.
+		*/
+		static_assert(SAVE_STATE_SIZE <= 0xFFFF, "Rewind RLE lengths are 16 bit");
+
+		// XOR in one pass first so the compiler can vectorise it, the scan below then skips zeroes a word at a time
+		m_delta.resize(SAVE_STATE_SIZE);
+		uint8* delta = m_delta.data();
+		for (size_t i = 0; i < SAVE_STATE_SIZE; ++i)
+		{
+			delta[i] = base ? state[i] ^ base[i] : state[i];
+		}
+
+		out.resize(SAVE_STATE_SIZE * 2);
+		uint8* write = out.data();
+
+		size_t i = 0;
+		while (i < SAVE_STATE_SIZE)
+		{
+			size_t zeroStart = i;
+			uint64 word;
+			while (i + sizeof(uint64) <= SAVE_STATE_SIZE && (memcpy(&word, delta + i, sizeof(uint64)), word == 0))
+			{
+				i += sizeof(uint64);
+			}
+
+			while (i < SAVE_STATE_SIZE && delta[i] == 0)
+			{
+				++i;
+			}
+
+			if (i == SAVE_STATE_SIZE)
+			{
+				break;
+			}
+
+			// Literal runs until MIN_ZERO_RUN zeroes in a row or the end
+			size_t literalStart = i;
+			size_t zeroes = 0;
+			while (i < SAVE_STATE_SIZE && zeroes < MIN_ZERO_RUN)
+			{
+				zeroes = delta[i] == 0 ? zeroes + 1 : 0;
+				++i;
+			}
+
+			if (zeroes == MIN_ZERO_RUN)
+			{
+				i -= MIN_ZERO_RUN;
+			}
+
+			uint16 zeroRun = (uint16)(literalStart - zeroStart);
+			uint16 literalLength = (uint16)(i - literalStart);
+
+			memcpy(write, &zeroRun, sizeof(uint16));
+			memcpy(write + sizeof(uint16), &literalLength, sizeof(uint16));
+			memcpy(write + sizeof(uint16) * 2, delta + literalStart, literalLength);
+			write += sizeof(uint16) * 2 + literalLength;
+		}
+
+		out.resize(write - out.data());
+	}
+
+	void Rewind::Decode(const std::vector<uint8>& data, uint8* state)
+	{
+		const uint8* read = data.data();
+		const uint8* end = read + data.size();
+
+		while (read < end)
+		{
+			uint16 zeroRun;
+			uint16 literalLength;
+			memcpy(&zeroRun, read, sizeof(uint16));
+			memcpy(&literalLength, read + sizeof(uint16), sizeof(uint16));
+			read += sizeof(uint16) * 2;
+
+			state += zeroRun;
+			for (uint16 i = 0; i < literalLength; ++i)
+			{
+				*state++ ^= *read++;
+			}
+		}
+	}
+
+	void Rewind::Trim()
+	{
+		while (m_memoryUsed > m_memoryBudget)
+		{
+			// Find the end of the oldest group, stop if it's the only one left
+			size_t groupEnd = 1;
+			while (groupEnd < m_snapshots.size() && m_snapshots[groupEnd].KeyframeDistance != 0)
+			{
+				++groupEnd;
+			}
+
+			if (groupEnd == m_snapshots.size())
+			{
+				break;
+			}
+
+			for (size_t i = 0; i < groupEnd; ++i)
+			{
+				m_memoryUsed -= m_snapshots.front().Data.size();
+				m_snapshots.pop_front();
+			}
+		}
+	}
+}
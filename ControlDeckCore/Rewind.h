@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Common.h"
+#include <deque>
+
+namespace ControlDeck
+{
+	class Console;
+
+	/*	Rewind - ring of per-frame save states kept within a memory budget
+	*	Every KeyframeInterval frames a keyframe is stored, the frames in between are stored as the XOR against that keyframe.
+	*	Most of a state doesn't change from frame to frame so the XOR is mostly zero bytes, both keyframes & deltas are
+	*	run length encoded on zero runs. Restoring any frame only decodes its keyframe & one delta, never a chain.
+	*	When the budget is exceeded the oldest keyframe is dropped along with the deltas that depend on it.
+	*/
+	class Rewind
+	{
+	public:
+		static const size_t DEFAULT_MEMORY_BUDGET = 16 * 1024 * 1024;
+		static const uint DEFAULT_KEYFRAME_INTERVAL = 60;
+
+		Rewind(size_t memoryBudget = DEFAULT_MEMORY_BUDGET, uint keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+		//!< Stores the console's current state as the newest frame, call once per frame between RunFrame() calls
+		void Push(const Console& console);
+
+		//!< Loads the newest stored frame into the console & drops it, returns false once there is nothing left
+		bool StepBack(Console& console);
+
+		void Clear();
+
+		//!< Drops the oldest frames straight away when the new budget is smaller
+		void SetMemoryBudget(size_t memoryBudget);
+
+		size_t GetMemoryBudget() const { return m_memoryBudget; }
+		size_t GetMemoryUsed() const { return m_memoryUsed; }
+		size_t GetFrameCount() const { return m_snapshots.size(); }
+
+	private:
+		struct Snapshot
+		{
+			std::vector<uint8> Data;	//!< RLE of the state, XORed with the keyframe for deltas
+			uint KeyframeDistance;		//!< 0 for a keyframe, otherwise the number of snapshots back to its keyframe
+		};
+
+		//!< Zero run encodes state ^ base, a null base encodes the state itself
+		void Encode(const uint8* state, const uint8* base, std::vector<uint8>& out);
+		//!< XORs the decoded bytes into state, which has to hold the base (or zeroes) already
+		static void Decode(const std::vector<uint8>& data, uint8* state);
+
+		//!< Drops whole keyframe groups from the front until the budget fits, the newest group is always kept
+		void Trim();
+
+		std::deque<Snapshot> m_snapshots;
+		size_t m_memoryBudget = DEFAULT_MEMORY_BUDGET;
+		size_t m_memoryUsed = 0;
+		uint m_keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+
+		// Scratch buffers, reused so pushing a frame doesn't allocate beyond the stored snapshot
+		std::vector<uint8> m_state;
+		std::vector<uint8> m_keyframe;		//!< Decoded keyframe of the newest group, deltas are taken against it
+		std::vector<uint8> m_delta;
+		std::vector<uint8> m_encoded;
+		bool m_keyframeValid = false;
+	};
+}
@@ -0,0 +1,54 @@
+#include "RunAhead.h"
+
+namespace ControlDeck
+{
+	void RunAhead::RunFrame(Console& console)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		// Only the last frame ahead is presented, the real frame & the ones in between don't need drawing
+		bool render = console.IsRenderEnabled();
+		console.SetRenderEnabled(render && m_frames == 0);
+		console.RunFrame();
+
+		auto real = std::chrono::high_resolution_clock::now();
+
+		if (m_frames > 0)
+		{
+			console.CaptureState(m_state);
+
+			for (uint i = 0; i < m_frames; ++i)
+			{
+				console.SetRenderEnabled(render && i == m_frames - 1);
+				console.RunFrame();
+			}
+
+			console.RestoreState(m_state);
+		}
+
+		console.SetRenderEnabled(render);
+
+		auto end = std::chrono::high_resolution_clock::now();
+
+		m_realSeconds += std::chrono::duration<double>(real - start).count();
+		m_aheadSeconds += std::chrono::duration<double>(end - real).count();
+		m_count++;
+	}
+
+	void RunAhead::PrintStats() const
+	{
+		double realMs = GetRealFrameMs();
+		double aheadMs = GetRunAheadMs();
+
+		printf("run ahead %u: real frame %.3fms, ahead %.3fms (%.2fx the real frame, %.3fms per frame ahead), %.1f%% of the 60Hz frame time\n",
+			m_frames, realMs, aheadMs, realMs > 0.0 ? aheadMs / realMs : 0.0, m_frames ? aheadMs / m_frames : 0.0,
+			(realMs + aheadMs) * 100.0 / FRAME_TIME_MS);
+	}
+
+	void RunAhead::ResetStats()
+	{
+		m_count = 0;
+		m_realSeconds = 0.0;
+		m_aheadSeconds = 0.0;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Common.h"
+#include "Console.h"
+#include <chrono>
+
+namespace ControlDeck
+{
+	/*	RunAhead - hides the game's own input lag frames
+	*	Each frame runs for real, then the state is captured, K more frames are run with the same input & the state is put
+	*	back. The PPU framebuffer isn't part of the state so it's left holding the K-th frame ahead, which is what gets
+	*	presented - input shows up on screen K frames sooner. Costs K extra frames of emulation per displayed frame, only the
+	*	last of which is rendered.
+	*	The frontend must keep the audio thread off the APU while RunFrame() runs, the speculative frames touch its channels.
+	*/
+	class RunAhead
+	{
+	public:
+		//!< Frames of emulation per frame at 60Hz, an extra frame ahead should cost well under this
+		static constexpr double FRAME_TIME_MS = 1000.0 / 60.0;
+
+		RunAhead(uint frames = 0) : m_frames(frames) {}
+
+		//!< Runs the real frame & then the frames ahead, frames 0 is a plain Console::RunFrame()
+		void RunFrame(Console& console);
+
+		void SetFrames(uint frames) { m_frames = frames; ResetStats(); }
+		uint GetFrames() const { return m_frames; }
+
+		//!< Average cost of the real frame & of the run ahead (capture, K frames & restore) since the last reset
+		double GetRealFrameMs() const { return m_count ? m_realSeconds * 1000.0 / m_count : 0.0; }
+		double GetRunAheadMs() const { return m_count ? m_aheadSeconds * 1000.0 / m_count : 0.0; }
+
+		//!< One line of the averages, the added cost as a multiple of the real frame & as a share of the 60Hz frame time
+		void PrintStats() const;
+		void ResetStats();
+
+	private:
+		uint m_frames = 0;
+		ConsoleState m_state;
+
+		uint64 m_count = 0;
+		double m_realSeconds = 0.0;
+		double m_aheadSeconds = 0.0;
+	};
+}
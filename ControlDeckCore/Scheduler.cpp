@@ -0,0 +1,110 @@
+#include "Scheduler.h"
+#include "CPU.h"
+#include "PPU.h"
+#include "APU.h"
+
+namespace ControlDeck
+{
+	//!< PPU presents the frame on dot 0 of scanline 260, the frame has ended once that dot has run
+	static const uint64 FRAME_END_DOT = (260 * PPU::CYCLES_PER_SCANLINE) + 1;
+	static const uint64 FRAME_DOTS = PPU::CYCLES_PER_SCANLINE * PPU::SCANLINES_PER_FRAME;
+
+	Scheduler::Scheduler(CPU* cpu, PPU* ppu, APU* apu)
+	{
+		m_cpu = cpu;
+		m_ppu = ppu;
+		m_apu = apu;
+		Reset();
+	}
+
+	void Scheduler::Reset()
+	{
+		m_events = {};
+		m_pending.fill(0);
+		m_cpuTime = 0;
+		m_ppu->SetTimestamp(0);
+		m_frameCount = 0;
+
+		Schedule(SchedulerEvent::FrameEnd, FRAME_END_DOT * PPU::MASTER_CLOCK_DIVIDER);
+		SchedulePPUEvent();
+	}
+
+	void Scheduler::SetState(const SchedulerState& state)
+	{
+		static_cast<SchedulerState&>(*this) = state;
+
+		m_events = {};
+		for (size_t event = 0; event < m_pending.size(); ++event)
+		{
+			m_events.push({ m_pending[event], (SchedulerEvent)event });
+		}
+	}
+
+	void Scheduler::Schedule(SchedulerEvent event, uint64 time)
+	{
+		m_pending[(size_t)event] = time;
+		m_events.push({ time, event });
+	}
+
+	void Scheduler::SchedulePPUEvent()
+	{
+		// The event dot has happened once it has been stepped, so stop one dot after it
+		Schedule(SchedulerEvent::PPU, m_ppu->GetTimestamp() + ((uint64)m_ppu->GetCyclesToNextEvent() + 1) * PPU::MASTER_CLOCK_DIVIDER);
+	}
+
+	void Scheduler::RunFrame()
+	{
+		while (true)
+		{
+			const PendingEvent next = m_events.top();
+
+			// Stale entry, the event was rescheduled
+			if (m_pending[(size_t)next.Event] != next.Time)
+			{
+				m_events.pop();
+				continue;
+			}
+
+			// CPU runs the whole slice in one go
+			if (m_cpuTime < next.Time)
+			{
+				uint32 cycles = (uint32)((next.Time - m_cpuTime + CPU::MASTER_CLOCK_DIVIDER - 1) / CPU::MASTER_CLOCK_DIVIDER);
+				m_cpuTime += (uint64)m_cpu->Run(cycles, m_cpuTime) * CPU::MASTER_CLOCK_DIVIDER;
+			}
+
+			// PPU & APU catch up to the CPU
+			m_ppu->CatchUp(m_cpuTime);
+			m_apu->CatchUp(m_cpuTime);
+
+			if (m_ppu->GetTimestamp() < next.Time)
+			{
+				continue;
+			}
+
+			m_events.pop();
+
+			if (HandleEvent(next.Event))
+			{
+				return;
+			}
+		}
+	}
+
+	bool Scheduler::HandleEvent(SchedulerEvent event)
+	{
+		switch (event)
+		{
+		case SchedulerEvent::PPU:
+			SchedulePPUEvent();
+			return false;
+
+		case SchedulerEvent::FrameEnd:
+			m_frameCount++;
+			Schedule(SchedulerEvent::FrameEnd, m_pending[(size_t)SchedulerEvent::FrameEnd] + (FRAME_DOTS * PPU::MASTER_CLOCK_DIVIDER));
+			return true;
+
+		default:
+			return false;
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Common.h"
+#include <array>
+#include <queue>
+
+namespace ControlDeck
+{
+	class CPU;
+	class PPU;
+	class APU;
+
+	//!< Events the scheduler can stop at, IRQ sources (APU frame counter, mapper) & DMA timing would be added here
+	enum class SchedulerEvent : uint8
+	{
+		PPU,		// Next point the CPU can see the PPU change - vblank set/ clear (NMI) or a sprite draw (sprite 0 hit)
+		FrameEnd,	// PPU has presented the frame, RunFrame() returns
+		Count
+	};
+
+	//!< Scheduler timeline, the event queue is rebuilt from m_pending so only the times need copying
+	struct SchedulerState
+	{
+		//!< Latest time scheduled per event, queue entries that don't match were replaced & are dropped when they surface
+		std::array<uint64, (size_t)SchedulerEvent::Count> m_pending = {};
+
+		//!< Master clock time the CPU has been run up to, the PPU keeps its own timestamp
+		uint64 m_cpuTime = 0;
+
+		uint64 m_frameCount = 0;
+	};
+
+	static_assert(std::has_unique_object_representations<SchedulerState>::value, "SchedulerState has padding");
+
+	/*	Scheduler - runs the CPU, PPU & APU against one master clock timeline
+	*	NTSC master clock is 21.477272 MHz, the CPU is clocked every 12 master cycles & the PPU every 4.
+	*	Pending events sit in a priority queue by timestamp. The CPU runs in one slice up to the earliest event, then the PPU
+	*	& APU are brought up to the same time before the next slice.
+	*	Within a slice the PPU is left behind, the CPU catches it up itself when it touches a PPU register or starts OAM DMA.
+	*	APU register writes are latched & picked up at the end of the slice.
+	*/
+	class Scheduler : private SchedulerState
+	{
+	public:
+		Scheduler() = delete;
+		Scheduler(CPU* cpu, PPU* ppu, APU* apu);
+
+		//!< Restarts the timeline at 0, the components must be at power on/ reset
+		void Reset();
+
+		//!< Runs until the PPU finishes the current frame
+		void RunFrame();
+
+		//!< Schedules event at master clock time, replacing any pending time for the same event
+		void Schedule(SchedulerEvent event, uint64 time);
+
+		uint64 GetMasterClock() const { return m_cpuTime; }
+		uint64 GetFrameCount() const { return m_frameCount; }
+
+		const SchedulerState& GetState() const { return *this; }
+
+		//!< Restores the timeline & requeues every pending event
+		void SetState(const SchedulerState& state);
+
+	private:
+		struct PendingEvent
+		{
+			uint64 Time;
+			SchedulerEvent Event;
+
+			//!< Events due at the same time run in SchedulerEvent order, so a rebuilt queue pops them exactly like the original
+			bool operator>(const PendingEvent& other) const { return Time != other.Time ? Time > other.Time : Event > other.Event; }
+		};
+
+		//!< Returns true when the event ends RunFrame()
+		bool HandleEvent(SchedulerEvent event);
+		void SchedulePPUEvent();
+
+		CPU* m_cpu = nullptr;
+		PPU* m_ppu = nullptr;
+		APU* m_apu = nullptr;
+
+		std::priority_queue<PendingEvent, std::vector<PendingEvent>, std::greater<PendingEvent>> m_events;
+	};
+}
@@ -0,0 +1,27 @@
+#include "TileCache.h"
+#include "PixelKernels.h"
+
+namespace ControlDeck
+{
+	TileCache::TileCache(const uint8* patternTables)
+	{
+		m_patternTables = patternTables;
+		InvalidateAll();
+	}
+
+	void TileCache::Decode(uint tile)
+	{
+		// Each tile is 16 bytes, the low bit plane's 8 rows followed by the high bit plane's, bit 7 is the leftmost pixel
+		const uint8* planes = m_patternTables + (tile * 16);
+		uint8* rows = &m_rows[tile * 64];
+		uint8* flipped = &m_flipped[tile * 64];
+
+		for (uint row = 0; row < 8; ++row)
+		{
+			Pixels::DecodeRow(planes[row], planes[row + 8], false, &rows[row * 8]);
+			Pixels::DecodeRow(planes[row], planes[row + 8], true, &flipped[row * 8]);
+		}
+
+		m_dirty[tile] = false;
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Common.h"
+#include <array>
+
+namespace ControlDeck
+{
+	/*	TileCache - the 512 pattern table tiles decoded to 2 bit colour indices, one byte per pixel
+	*	Each tile is decoded on first use after its 16 bytes of CHR change, with a horizontally flipped copy for sprites.
+	*	Writes through PPU::WriteMemory8 invalidate the tile they land in, anything that replaces CHR wholesale (state
+	*	restore, a mapper switching CHR banks) has to call InvalidateAll().
+	*/
+	class TileCache
+	{
+	public:
+		static const uint TILE_COUNT = 512;
+
+		//!< patternTables is PPU $0000 - $1FFF, read again whenever a tile is decoded
+		TileCache(const uint8* patternTables);
+
+		//!< 8 colour indices for row (0 - 7) of the tile at pattern address tileAddress, left to right unless flipped
+		const uint8* GetRow(uint16 tileAddress, uint row, bool flipX = false)
+		{
+			uint tile = (tileAddress >> 4) & (TILE_COUNT - 1);
+
+			if (m_dirty[tile])
+			{
+				Decode(tile);
+			}
+
+			return &(flipX ? m_flipped : m_rows)[(tile * 64) + (row * 8)];
+		}
+
+		//!< Call on a write to PPU address, only pattern table addresses have any effect
+		void Invalidate(uint16 address)
+		{
+			if (address < 0x2000)
+			{
+				m_dirty[address >> 4] = true;
+			}
+		}
+
+		void InvalidateAll() { m_dirty.fill(true); }
+
+	private:
+		void Decode(uint tile);
+
+		const uint8* m_patternTables = nullptr;
+
+		std::array<uint8, TILE_COUNT * 64> m_rows = {};
+		std::array<uint8, TILE_COUNT * 64> m_flipped = {};
+		std::array<bool, TILE_COUNT> m_dirty = {};
+	};
+}
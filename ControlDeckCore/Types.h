@@ -13,6 +13,7 @@ typedef unsigned short uint16;
 typedef short int16; 
 typedef unsigned int uint32; 
 typedef int int32; 
+typedef unsigned long long uint64; 
 typedef uint32 uint;
 
 template <class T>
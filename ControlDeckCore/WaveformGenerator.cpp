@@ -0,0 +1,79 @@
+#include "WaveformGenerator.h"
+
+void ControlDeck::WaveformGenerator::Init(WaveformType type)
+{
+	m_waveformType = type;
+}
+
+void ControlDeck::WaveformGenerator::SetHertz(float value)
+{
+	m_hertz = value;
+}
+
+
+void ControlDeck::WaveformGenerator::Generate(uint8* stream, int len)
+{
+	if (m_muted)
+	{
+		return;
+	}
+
+	float amplitude = 1.0f; // 0-1
+	float sampleRate = SAMPLE_RATE;
+	float sampleInSeconds = SAMPLES_PER_BUFFER/ sampleRate;
+	float samplePerCPU = sampleRate / 1789773.0f;
+	float frequency = ((2 * PI * m_hertz)/ sampleRate);
+
+	// Sine
+	//for (int i = 0; i < len; i++)
+	//{
+	//	m_waveOffset++;
+	//	m_waveData[i] = (Uint8)((amplitude * 127.5f * sin(frequency * (double)m_waveOffset)) + 127.5);
+	//}
+
+	double halfPi = PI * 0.5f;
+	
+	if (m_waveformType == WaveformType::TRIANGLE)
+	{
+		// Triangle
+		for (int i = 0; i < len; i++)
+		{
+			float freq = frequency * (double)m_waveOffset;
+			float offstep = floor(freq / halfPi);
+			float t = (freq - offstep);
+
+			m_waveOffset++;
+			//stream[i] = t * 255.0f;
+		}
+	}
+	else if (m_waveformType == WaveformType::PULSE)
+	{
+		float pulsePeriod = (1790000/2) / ((m_hertz + 1) * 8);
+		pulsePeriod -= 1;
+
+		float duty = 0.125;
+
+		if (m_duty > 0)
+		{
+			duty = m_duty / 4.0f; 
+		}
+		
+		float highTime = pulsePeriod * duty;
+
+		// Fill the stream with the pulse wave
+		for (int i = 0; i < len; i++) {
+			// Generate the pulse wave (alternating between 0 and 255)
+			if (m_pulseCounter < highTime) {
+				stream[i] = (m_volume/15) * 255;  // On (max value for 8-bit)
+			}
+			else {
+				stream[i] = 0;    // Off (min value for 8-bit)
+			}
+
+			m_pulseCounter++;
+			if (m_pulseCounter >= pulsePeriod) {
+				m_pulseCounter = 0;  // Reset to create a new cycle
+			}
+		}
+	}
+}
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "Common.h"
-#include <SDL2/SDL_audio.h>
 
 namespace ControlDeck
 {
@@ -11,18 +10,17 @@ namespace ControlDeck
 		TRIANGLE = 0x2
 	};
 
+	//!< Channel state only, no heap members - the generators are copied as part of APUState
 	class WaveformGenerator
 	{
 	private:
-		const int m_samples = 256;
-		
 		int m_waveOffset = 0;
+		int m_pulseCounter = 0;
 		int m_hertz = 44;
 		float m_duty = 0;
 		float m_volume = 15;
 		bool m_muted = true;
-		std::vector<Uint8> m_waveData;
-		SDL_AudioSpec m_audioSpec;
+		uint8 m_reserved[3] = {};		//!< Explicit padding, APUState is copied byte for byte
 
 		/* APU Length counter, duration of waveform
 		* see https://www.nesdev.org/wiki/APU_Length_Counter
@@ -33,9 +31,15 @@ namespace ControlDeck
 		int m_lengthCounter = 0;
 		WaveformType m_waveformType = WaveformType::PULSE;
 
-		static void AudioCallback(void* userdata, Uint8* stream, int len);
 	public:
 		void Init(WaveformType type);
+
+		//!< Fills stream with len unsigned 8 bit mono samples at SAMPLE_RATE, stream is left untouched while muted
+		void Generate(uint8* stream, int len);
+
+		static const int SAMPLE_RATE = 44100;
+		static const int SAMPLES_PER_BUFFER = 256;
+
 		void SetHertz(float value);
 		void SetVolume(float value) { m_volume = value; }
 		void SetDuty(float value) { m_duty = value; }
@@ -0,0 +1,527 @@
+// Copyright  Allan Moore April 2020
+
+#include "Common.h"
+#include "Console.h"
+#include "ConsolePool.h"
+#include "PixelKernels.h"
+#include "RunAhead.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <sstream>
+
+using namespace ControlDeck;
+
+/*	Headless batch runner - links only the core library, no window, audio device or frame pacing.
+*	Runs a ROM for a fixed number of frames as fast as possible, then prints frame & RAM hashes and throughput.
+*	With -consoles N the ROM runs on N independent consoles spread over a ConsolePool, every console gets the same input
+*	so their hashes must agree - a mismatch means state is leaking between consoles.
+*	With -runahead K every frame also runs K frames ahead & restores, as the frontend does, & the cost is printed. The RAM
+*	hash matches a run without it, the frame hash is that of the frame K ahead. Consoles run on the calling thread then.
+*
+*	-norender runs with rendering off, timing & RAM are unaffected so the RAM hash must match a rendered run.
+*	-mode jitverify runs the JIT with every native block re-run on the interpreter, the first mismatch is printed & aborts the run.
+*	-mode all spreads the consoles (at least 3) over the interpreter, block cache & JIT, their hashes must agree.
+*	-fusionreport prints console 0's fused pair hit rates after the run, only instructions run by the block cache count so it
+*	needs -mode blockcache (the JIT runs hot blocks natively). -nofusion turns pair fusion off for A/B runs.
+*
+*	-testrom writes one of the built in NROM programs below, small checks & benchmarks that need no ROM files.
+*
+*	Usage: ControlDeckHeadless <rom> [-frames N] [-input script] [-mode interpreter|blockcache|jit|jitverify|all] [-noidleskip]
+*		[-consoles N] [-threads N] [-runahead K] [-norender] [-fusionreport] [-nofusion]
+*	       ControlDeckHeadless -pixelbench
+*	       ControlDeckHeadless -testrom <name> <out.nes>
+*
+*	Input scripts hold one "<frame> <buttons>" entry per line, the buttons stay held from that frame until the next entry.
+*	Buttons are any of A B SELECT START UP DOWN LEFT RIGHT, "-" releases everything & # starts a comment, e.g.
+*		60 START
+*		62 -
+*		120 RIGHT A
+*/
+
+//!< FNV-1a, stable across runs & platforms so hashes can be compared between builds
+static uint64 HashBytes(const void* data, size_t size, uint64 hash = 14695981039346656037ULL)
+{
+    const uint8* bytes = (const uint8*)data;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static bool ParseButton(const String& name, uint8& button)
+{
+    static const std::pair<const char*, Controller> buttons[] =
+    {
+        { "A", Controller::A }, { "B", Controller::B }, { "SELECT", Controller::SELECT }, { "START", Controller::START },
+        { "UP", Controller::UP }, { "DOWN", Controller::DOWN }, { "LEFT", Controller::LEFT }, { "RIGHT", Controller::RIGHT }
+    };
+
+    for (const auto& entry : buttons)
+    {
+        if (name == entry.first)
+        {
+            button = (uint8)entry.second;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//!< Frame number -> controller 1 state from that frame on
+static bool LoadInputScript(const char* path, std::map<uint64, uint8>& script)
+{
+    std::ifstream file(path);
+
+    if (!file.is_open())
+    {
+        printf("Unable to open input script [%s]\n", path);
+        return false;
+    }
+
+    String line;
+    uint lineNumber = 0;
+
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream tokens(line);
+        uint64 frame = 0;
+
+        if (!(tokens >> frame))
+        {
+            continue;
+        }
+
+        uint8 state = 0;
+        String name;
+
+        while (tokens >> name)
+        {
+            uint8 button = 0;
+
+            if (name == "-")
+            {
+                continue;
+            }
+
+            if (!ParseButton(name, button))
+            {
+                printf("Unknown button [%s] on line %u of input script\n", name.c_str(), lineNumber);
+                return false;
+            }
+
+            state |= button;
+        }
+
+        script[frame] = state;
+    }
+
+    return true;
+}
+
+//!< Times kernel over a frame's worth of 8 pixel rows repeatedly, returns pixels per nanosecond
+template <class Kernel>
+static double TimePixelKernel(Kernel kernel)
+{
+    const uint rows = (PPU::FRAME_WIDTH * PPU::FRAME_HEIGHT) / 8;
+    const uint repeats = 2000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (uint repeat = 0; repeat < repeats; ++repeat)
+    {
+        for (uint row = 0; row < rows; ++row)
+        {
+            kernel(row);
+        }
+    }
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+    return (double)rows * 8 * repeats / nanoseconds;
+}
+
+//!< Pixels per nanosecond of the tile row kernels, the scalar reference against the SIMD path compiled in
+static int RunPixelBenchmark()
+{
+    const uint pixels = PPU::FRAME_WIDTH * PPU::FRAME_HEIGHT;
+
+    std::mt19937 random(1);
+    std::vector<uint8> planes(pixels / 4);
+    std::vector<uint8> decoded(pixels);
+    std::vector<uint8> indices(pixels);
+    std::vector<uint> frame(pixels);
+    const uint colours[4] = { 0x000000, 0xF83800, 0x0078F8, 0xFCFCFC };
+
+    for (uint8& plane : planes)
+    {
+        plane = (uint8)random();
+    }
+
+    // Sprites are mostly transparent
+    for (uint8& index : indices)
+    {
+        index = random() % 3 == 0 ? (uint8)(random() % 4) : 0;
+    }
+
+    uint64 check = 0;
+
+    double decodeScalar = TimePixelKernel([&](uint row) { Pixels::DecodeRowScalar(planes[row * 2], planes[(row * 2) + 1], row & 1, &decoded[row * 8]); });
+    double decode = TimePixelKernel([&](uint row) { Pixels::DecodeRow(planes[row * 2], planes[(row * 2) + 1], row & 1, &decoded[row * 8]); });
+
+    double mapScalar = TimePixelKernel([&](uint row) { Pixels::MapRowScalar(&indices[row * 8], colours, &frame[row * 8]); });
+    double map = TimePixelKernel([&](uint row) { Pixels::MapRow(&indices[row * 8], colours, &frame[row * 8]); });
+
+    double blendScalar = TimePixelKernel([&](uint row) { check += Pixels::BlendSpriteRowScalar(&indices[row * 8], colours, &frame[row * 8]); });
+    double blend = TimePixelKernel([&](uint row) { check += Pixels::BlendSpriteRow(&indices[row * 8], colours, &frame[row * 8]); });
+
+    for (uint pixel = 0; pixel < pixels; ++pixel)
+    {
+        check += frame[pixel] + decoded[pixel];
+    }
+
+    printf("pixel kernels %s (check %llx)\n", Pixels::GetKernelName(), (unsigned long long)check);
+    printf("              scalar      %s\n", Pixels::GetKernelName());
+    printf("decode row    %6.2f  %9.2f pixels/ns\n", decodeScalar, decode);
+    printf("map row       %6.2f  %9.2f pixels/ns\n", mapScalar, map);
+    printf("sprite blend  %6.2f  %9.2f pixels/ns\n", blendScalar, blend);
+
+    return 0;
+}
+
+//!< A program assembled at $C000, reset starts at the first byte & NMI/ IRQ at NMIOffset
+struct TestProgram
+{
+    const char* Name;
+    const char* Description;
+    uint16 NMIOffset;
+    std::vector<uint8> Code;
+};
+
+static const TestProgram TEST_PROGRAMS[] =
+{
+    // The NMI handler logs $10, the INCs after STA $2000 must not have run yet - every entry of the log is 0
+    { "nmienable", "waits for vblank with NMI off then enables it, the pending NMI is taken straight after the STA $2000", 0x21,
+    {
+        0x78, 0xD8, 0xA2, 0xFF, 0x9A,                   // C000 SEI, CLD, LDX #$FF, TXS
+        0xA9, 0x00, 0x8D, 0x00, 0x20, 0x85, 0x10,       // C005 LDA #$00, STA $2000, STA $10
+        0x2C, 0x02, 0x20, 0x10, 0xFB,                   // C00C BIT $2002, BPL $C00C
+        0xA9, 0x80, 0x8D, 0x00, 0x20,                   // C011 LDA #$80, STA $2000
+        0xE6, 0x10, 0xE6, 0x10, 0xE6, 0x10, 0xE6, 0x10, // C016 INC $10 x4
+        0x4C, 0x05, 0xC0,                               // C01E JMP $C005
+        0xA6, 0x12, 0xA5, 0x10, 0x9D, 0x00, 0x03,       // C021 NMI: LDX $12, LDA $10, STA $0300,X
+        0xE6, 0x12, 0x40                                // C028 INC $12, RTI
+    } },
+
+    // Store heavy CPU benchmark, run with -norender & compare instrs/sec. Never touches the stack so page 1 is cleared too
+    { "storeloop", "clears all 2K of RAM with STA abs,X in a tight loop, a new value every pass", 0x28,
+    {
+        0x78, 0xD8, 0xA2, 0xFF, 0x9A,                   // C000 SEI, CLD, LDX #$FF, TXS
+        0xA2, 0x00,                                     // C005 LDX #$00
+        0x9D, 0x00, 0x00, 0x9D, 0x00, 0x01,             // C007 STA $0000,X, STA $0100,X
+        0x9D, 0x00, 0x02, 0x9D, 0x00, 0x03,             // C00D STA $0200,X, STA $0300,X
+        0x9D, 0x00, 0x04, 0x9D, 0x00, 0x05,             // C013 STA $0400,X, STA $0500,X
+        0x9D, 0x00, 0x06, 0x9D, 0x00, 0x07,             // C019 STA $0600,X, STA $0700,X
+        0xE8, 0xD0, 0xE5,                               // C01F INX, BNE $C007
+        0x18, 0x69, 0x01,                               // C022 CLC, ADC #$01
+        0x4C, 0x05, 0xC0,                               // C025 JMP $C005
+        0x40                                            // C028 NMI: RTI
+    } },
+};
+
+//!< iNES image of program - mapper 0, one 16K PRG bank (mirrored at $8000 & $C000) & a blank 8K CHR bank
+static bool WriteTestRom(const TestProgram& program, const char* path)
+{
+    std::vector<uint8> image = { 'N', 'E', 'S', 0x1A, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    std::vector<uint8> prg(0x4000, 0xEA);
+    std::copy(program.Code.begin(), program.Code.end(), prg.begin());
+
+    // Vectors at $FFFA - NMI, reset, IRQ
+    const uint16 nmi = 0xC000 + program.NMIOffset;
+    const uint8 vectors[] = { (uint8)nmi, (uint8)(nmi >> 8), 0x00, 0xC0, (uint8)nmi, (uint8)(nmi >> 8) };
+    std::copy(std::begin(vectors), std::end(vectors), prg.end() - 6);
+
+    image.insert(image.end(), prg.begin(), prg.end());
+    image.resize(image.size() + 0x2000, 0);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char*)image.data(), image.size());
+    return file.good();
+}
+
+static int RunTestRomWriter(const char* name, const char* path)
+{
+    for (const TestProgram& program : TEST_PROGRAMS)
+    {
+        if (name && path && String(name) == program.Name)
+        {
+            if (!WriteTestRom(program, path))
+            {
+                printf("Unable to write [%s]\n", path);
+                return 1;
+            }
+
+            printf("Wrote %s to %s\n", program.Name, path);
+            return 0;
+        }
+    }
+
+    printf("Test roms:\n");
+    for (const TestProgram& program : TEST_PROGRAMS)
+    {
+        printf("  %-12s %s\n", program.Name, program.Description);
+    }
+
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 2 && String(argv[1]) == "-pixelbench")
+    {
+        return RunPixelBenchmark();
+    }
+
+    if (argc >= 2 && String(argv[1]) == "-testrom")
+    {
+        return RunTestRomWriter(argc > 2 ? argv[2] : nullptr, argc > 3 ? argv[3] : nullptr);
+    }
+
+    if (argc < 2)
+    {
+        printf("Usage: %s <rom> [-frames N] [-input script] [-mode interpreter|blockcache|jit|jitverify|all] [-noidleskip] [-consoles N] [-threads N] [-runahead K] [-norender] [-fusionreport] [-nofusion]\n       %s -pixelbench\n       %s -testrom <name> <out.nes>\n", argv[0], argv[0], argv[0]);
+        return 1;
+    }
+
+    uint64 frames = 600;
+    const char* inputPath = nullptr;
+    String mode = "interpreter";
+    bool idleSkip = true;
+    uint consoleCount = 1;
+    uint threads = 0;
+    uint runAheadFrames = 0;
+    bool render = true;
+    bool fusion = true;
+    bool fusionReport = false;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        String arg = argv[i];
+
+        if (arg == "-frames" && i + 1 < argc)
+        {
+            frames = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-input" && i + 1 < argc)
+        {
+            inputPath = argv[++i];
+        }
+        else if (arg == "-mode" && i + 1 < argc)
+        {
+            mode = argv[++i];
+        }
+        else if (arg == "-consoles" && i + 1 < argc)
+        {
+            consoleCount = std::max(1, atoi(argv[++i]));
+        }
+        else if (arg == "-threads" && i + 1 < argc)
+        {
+            threads = std::max(0, atoi(argv[++i]));
+        }
+        else if (arg == "-runahead" && i + 1 < argc)
+        {
+            runAheadFrames = std::max(0, atoi(argv[++i]));
+        }
+        else if (arg == "-norender")
+        {
+            render = false;
+        }
+        else if (arg == "-noidleskip")
+        {
+            idleSkip = false;
+        }
+        else if (arg == "-nofusion")
+        {
+            fusion = false;
+        }
+        else if (arg == "-fusionreport")
+        {
+            fusionReport = true;
+        }
+        else
+        {
+            printf("Unknown option [%s]\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    std::map<uint64, uint8> script;
+    if (inputPath && !LoadInputScript(inputPath, script))
+    {
+        return 1;
+    }
+
+    // Cross mode check, console i runs ALL_MODES[i % 3]
+    static const char* const ALL_MODES[] = { "interpreter", "blockcache", "jit" };
+    if (mode == "all")
+    {
+        consoleCount = std::max(consoleCount, 3u);
+    }
+
+    std::vector<UniquePtr<Console>> consoles;
+    std::vector<Console*> batch;
+    std::vector<String> consoleModes;
+    bool warnedJIT = false;
+
+    for (uint i = 0; i < consoleCount; ++i)
+    {
+        consoles.push_back(std::make_unique<Console>());
+        Console* console = consoles.back().get();
+
+        if (!console->LoadCartridge(argv[1]))
+        {
+            printf("Unable to load rom [%s]\n", argv[1]);
+            return 1;
+        }
+
+        console->SetRenderEnabled(render);
+
+        CPU* cpu = console->GetCPU();
+        cpu->SetIdleSkipEnabled(idleSkip);
+        cpu->SetFusionEnabled(fusion);
+
+        const String consoleMode = mode == "all" ? ALL_MODES[i % 3] : mode;
+
+        if (consoleMode == "blockcache")
+        {
+            cpu->SetBlockCacheEnabled(true);
+        }
+        else if (consoleMode == "jit" || consoleMode == "jitverify")
+        {
+            cpu->SetBlockCacheEnabled(true);
+            if (!cpu->SetJITEnabled(true) && !warnedJIT)
+            {
+                printf("JIT unavailable on this host, running the block cache\n");
+                warnedJIT = true;
+            }
+            cpu->SetJITVerifyEnabled(consoleMode == "jitverify");
+        }
+        else if (consoleMode != "interpreter")
+        {
+            printf("Unknown mode [%s]\n", mode.c_str());
+            return 1;
+        }
+
+        batch.push_back(console);
+        consoleModes.push_back(consoleMode);
+    }
+
+    ConsolePool pool(threads ? threads : std::min(consoleCount, std::max(1u, std::thread::hardware_concurrency())));
+    std::vector<RunAhead> runAheads(consoleCount, RunAhead(runAheadFrames));
+    auto nextInput = script.begin();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Core errors (bad opcodes, -mode jitverify mismatches) are thrown as strings, the pool passes them back to this thread
+    try
+    {
+        // Run straight through to the next input change, consoles only sync with the pool between script entries
+        for (uint64 frame = 0; frame < frames;)
+        {
+            if (nextInput != script.end() && nextInput->first == frame)
+            {
+                for (Console* console : batch)
+                {
+                    console->SetControllerState(nextInput->second);
+                }
+                ++nextInput;
+            }
+
+            uint64 untilInput = (nextInput != script.end() && nextInput->first < frames) ? nextInput->first : frames;
+
+            if (runAheadFrames)
+            {
+                for (; frame < untilInput; ++frame)
+                {
+                    for (uint i = 0; i < consoleCount; ++i)
+                    {
+                        runAheads[i].RunFrame(*batch[i]);
+                    }
+                }
+            }
+            else
+            {
+                pool.RunFrames(batch, (uint)(untilInput - frame));
+            }
+
+            frame = untilInput;
+        }
+    }
+    catch (const char* message)
+    {
+        printf("Run aborted: %s\n", message);
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    uint64 frameHash = 0;
+    uint64 ramHash = 0;
+    uint64 instructions = 0;
+    uint64 skippedCycles = 0;
+    uint mismatches = 0;
+
+    for (uint i = 0; i < consoleCount; ++i)
+    {
+        const std::vector<uint>& frameBuffer = batch[i]->GetPPU()->GetFrameBuffer();
+        const std::array<uint8, 0x800>& workRAM = batch[i]->GetCPU()->GetWorkRAM();
+        uint64 consoleFrameHash = HashBytes(frameBuffer.data(), frameBuffer.size() * sizeof(uint));
+        uint64 consoleRAMHash = HashBytes(workRAM.data(), workRAM.size());
+
+        if (i == 0)
+        {
+            frameHash = consoleFrameHash;
+            ramHash = consoleRAMHash;
+        }
+        else if (consoleFrameHash != frameHash || consoleRAMHash != ramHash)
+        {
+            printf("console %u (%s) hashes differ from console 0 (%s): frame %016llx ram %016llx\n", i, consoleModes[i].c_str(), consoleModes[0].c_str(),
+                (unsigned long long)consoleFrameHash, (unsigned long long)consoleRAMHash);
+            mismatches++;
+        }
+
+        instructions += batch[i]->GetCPU()->GetInstructionCount();
+        skippedCycles += batch[i]->GetCPU()->GetIdleSkippedCycles();
+    }
+
+    uint64 totalFrames = frames * consoleCount;
+
+    printf("consoles      %u on %u threads\n", consoleCount, pool.GetThreadCount());
+    printf("frames        %llu per console\n", (unsigned long long)frames);
+    printf("frame hash    %016llx\n", (unsigned long long)frameHash);
+    printf("ram hash      %016llx\n", (unsigned long long)ramHash);
+    printf("time          %.3fs\n", seconds);
+    printf("frames/sec    %.1f\n", totalFrames / seconds);
+    printf("instrs/sec    %.1fM (%llu instructions, %llu idle cycles skipped)\n", instructions / seconds / 1000000.0,
+        (unsigned long long)instructions, (unsigned long long)skippedCycles);
+
+    if (runAheadFrames)
+    {
+        runAheads[0].PrintStats();
+    }
+
+    if (fusionReport)
+    {
+        batch[0]->GetCPU()->PrintFusionReport();
+    }
+
+    return mismatches ? 2 : 0;
+}